@@ -2,70 +2,78 @@
 
 #include <stdint.h>
 
+#include <ads-b/field.hpp>
+
 namespace ssr::ads_b::es
 {
     /*
      * Purpose: To provide accurate airborne position information.
      */
-    struct __attribute__((__packed__)) AirbornePosition
+    struct AirbornePosition
     {
-        uint8_t format_type : 5;
-        uint8_t surveillance_status : 2;
-        uint8_t sa_flag : 1; //SAF, Single Antenna Flag
-        uint16_t altitude : 12;
-        uint8_t t_flag : 1; // Is UTC synced
-        uint8_t f_flag : 1; // CPR Format Odd/Event
-        uint32_t latitude : 17;
-        uint32_t longitude : 17;
+        me_type me;
+
+        constexpr uint32_t format_type() const { return Field<1, 5>::Get(me); }
+        constexpr uint32_t surveillance_status() const { return Field<6, 2>::Get(me); }
+        constexpr uint32_t sa_flag() const { return Field<8, 1>::Get(me); } //SAF, Single Antenna Flag
+        constexpr uint32_t altitude() const { return Field<9, 12>::Get(me); }
+        constexpr uint32_t t_flag() const { return Field<21, 1>::Get(me); } //Is UTC synced
+        constexpr uint32_t f_flag() const { return Field<22, 1>::Get(me); } //CPR Format Odd/Even
+        constexpr uint32_t latitude() const { return Field<23, 17>::Get(me); }
+        constexpr uint32_t longitude() const { return Field<40, 17>::Get(me); }
     };
-    static_assert(sizeof(AirbornePosition) == 7);
+    static_assert(sizeof(AirbornePosition) == sizeof(me_type));
 
     /*
      * Purpose: To provide accurate surface position information.
      */
-    struct __attribute__((__packed__)) SurfacePosition
+    struct SurfacePosition
     {
-        uint8_t format_type : 4;
-        uint8_t : 1;
-        uint8_t movement : 7;
-        uint8_t status : 1; //0=invalid, 1=valid
-        uint8_t ground_track : 7;
-        uint8_t t_flag : 1;
-        uint8_t f_flag : 1;
-        uint32_t latitude : 17;
-        uint32_t longitude : 17;
+        me_type me;
+
+        constexpr uint32_t format_type() const { return Field<1, 5>::Get(me); }
+        constexpr uint32_t movement() const { return Field<6, 7>::Get(me); }
+        constexpr uint32_t status() const { return Field<13, 1>::Get(me); } //0=invalid, 1=valid
+        constexpr uint32_t ground_track() const { return Field<14, 7>::Get(me); }
+        constexpr uint32_t t_flag() const { return Field<21, 1>::Get(me); }
+        constexpr uint32_t f_flag() const { return Field<22, 1>::Get(me); }
+        constexpr uint32_t latitude() const { return Field<23, 17>::Get(me); }
+        constexpr uint32_t longitude() const { return Field<40, 17>::Get(me); }
     };
-    static_assert(sizeof(SurfacePosition) == 7);
+    static_assert(sizeof(SurfacePosition) == sizeof(me_type));
 
     /*
      * Purpose: To provide information on the capability and status
      * of the extended squitter rate of the transponder.
      */
-    struct __attribute__((__packed__)) Status
+    struct Status
     {
-        uint8_t transmission_rate : 2;
-        uint8_t altitude_type : 1;
-        uint64_t : 53; //reserved
+        me_type me;
+
+        constexpr uint32_t transmission_rate() const { return Field<1, 2>::Get(me); }
+        constexpr uint32_t altitude_type() const { return Field<3, 1>::Get(me); }
     };
-    static_assert(sizeof(Status) == 7);
+    static_assert(sizeof(Status) == sizeof(me_type));
 
     /*
      * Purpose: To provide aircraft identification and category.
      */
-    struct __attribute__((__packed__)) IdentAndCategory
+    struct IdentAndCategory
     {
-        uint8_t format_type : 5;
-        uint8_t category : 3;
-        char char_1 : 6;
-        char char_2 : 6;
-        char char_3 : 6;
-        char char_4 : 6;
-        char char_5 : 6;
-        char char_6 : 6;
-        char char_7 : 6;
-        char char_8 : 6;
+        me_type me;
+
+        constexpr uint32_t format_type() const { return Field<1, 5>::Get(me); }
+        constexpr uint32_t category() const { return Field<6, 3>::Get(me); }
+        constexpr uint32_t char_1() const { return Field<9, 6>::Get(me); }
+        constexpr uint32_t char_2() const { return Field<15, 6>::Get(me); }
+        constexpr uint32_t char_3() const { return Field<21, 6>::Get(me); }
+        constexpr uint32_t char_4() const { return Field<27, 6>::Get(me); }
+        constexpr uint32_t char_5() const { return Field<33, 6>::Get(me); }
+        constexpr uint32_t char_6() const { return Field<39, 6>::Get(me); }
+        constexpr uint32_t char_7() const { return Field<45, 6>::Get(me); }
+        constexpr uint32_t char_8() const { return Field<51, 6>::Get(me); }
     };
-    static_assert(sizeof(IdentAndCategory) == 7);
+    static_assert(sizeof(IdentAndCategory) == sizeof(me_type));
 
     /*
      * Purpose: To provide additional state information for both
@@ -73,25 +81,26 @@ namespace ssr::ads_b::es
      * 
      * This covers Subtype 1/2 in BDS register 0,9
      */
-    struct __attribute__((__packed__)) GroundSpeed
+    struct GroundSpeed
     {
-        uint8_t format_type : 5;
-        uint8_t format_subtype : 3; //TODO: Define (Page 58)
-        uint8_t change_flag : 1;    //Intent Change Flag
-        uint8_t ifr_flag : 1;       //TODO: Define (Page 58)
-        uint8_t accuracy : 3;       //TODO: Define (Page 58)
-        uint8_t ew_direction : 1;   //0=East, 1=West
-        uint16_t ew_velocity : 10;  //East-West Velocity
-        uint8_t ns_direction : 1;   //0=North, 1=South
-        uint16_t ns_velocity : 10;
-        uint8_t vr_source : 1;    // Vertical Rate Source [0=GNSS, 1=Baro]
-        uint8_t vr_direction : 1; // Vertical Rate Direction [0=Up, 1=Down]
-        uint16_t vertical_rate : 9;
-        uint8_t : 2;                 //reserved for turn indicator
-        uint8_t gnss_sign : 1;       //0=Above Baro, 1=Below Baro
-        uint8_t gnss_difference : 7; //Difference in altitude from baro
+        me_type me;
+
+        constexpr uint32_t format_type() const { return Field<1, 5>::Get(me); }
+        constexpr uint32_t format_subtype() const { return Field<6, 3>::Get(me); } //TODO: Define (Page 58)
+        constexpr uint32_t change_flag() const { return Field<9, 1>::Get(me); } //Intent Change Flag
+        constexpr uint32_t ifr_flag() const { return Field<10, 1>::Get(me); } //TODO: Define (Page 58)
+        constexpr uint32_t accuracy() const { return Field<11, 3>::Get(me); } //TODO: Define (Page 58)
+        constexpr uint32_t ew_direction() const { return Field<14, 1>::Get(me); } //0=East, 1=West
+        constexpr uint32_t ew_velocity() const { return Field<15, 10>::Get(me); } //East-West Velocity
+        constexpr uint32_t ns_direction() const { return Field<25, 1>::Get(me); } //0=North, 1=South
+        constexpr uint32_t ns_velocity() const { return Field<26, 10>::Get(me); }
+        constexpr uint32_t vr_source() const { return Field<36, 1>::Get(me); } //Vertical Rate Source [0=GNSS, 1=Baro]
+        constexpr uint32_t vr_direction() const { return Field<37, 1>::Get(me); } //Vertical Rate Direction [0=Up, 1=Down]
+        constexpr uint32_t vertical_rate() const { return Field<38, 9>::Get(me); }
+        constexpr uint32_t gnss_sign() const { return Field<49, 1>::Get(me); } //0=Above Baro, 1=Below Baro
+        constexpr uint32_t gnss_difference() const { return Field<50, 7>::Get(me); } //Difference in altitude from baro
     };
-    static_assert(sizeof(GroundSpeed) == 7);
+    static_assert(sizeof(GroundSpeed) == sizeof(me_type));
 
     /*
      * Purpose: To provide additional state information for both
@@ -99,101 +108,105 @@ namespace ssr::ads_b::es
      * 
      * This covers Subtype 3/4 in BDS register 0,9
      */
-    struct __attribute__((__packed__)) AirSpeed
+    struct AirSpeed
     {
-        uint8_t format_type : 5;
-        uint8_t format_subtype : 3; //TODO: Define (Page 59)
-        uint8_t change_flag : 1;    //Intent Change Flag
-        uint8_t ifr_flag : 1;       //TODO: Define (Page 59)
-        uint8_t accuracy : 3;       //TODO: Define (Page 59)
-        uint8_t status : 1;         //0=Magnetic heading not available, 1=Available
-        uint16_t heading : 10;
-        uint8_t type : 1; //0=IAS, 1=TAS
-        uint16_t airspeed : 10;
-        uint8_t vr_source : 1;    // Vertical Rate Source [0=GNSS, 1=Baro]
-        uint8_t vr_direction : 1; // Vertical Rate Direction [0=Up, 1=Down]
-        uint16_t vertical_rate : 9;
-        uint8_t : 2;                 //reserved for turn indicator
-        uint8_t gnss_sign : 1;       //0=Above Baro, 1=Below Baro
-        uint8_t gnss_difference : 7; //Difference in altitude from baro
+        me_type me;
+
+        constexpr uint32_t format_type() const { return Field<1, 5>::Get(me); }
+        constexpr uint32_t format_subtype() const { return Field<6, 3>::Get(me); } //TODO: Define (Page 59)
+        constexpr uint32_t change_flag() const { return Field<9, 1>::Get(me); } //Intent Change Flag
+        constexpr uint32_t ifr_flag() const { return Field<10, 1>::Get(me); } //TODO: Define (Page 59)
+        constexpr uint32_t accuracy() const { return Field<11, 3>::Get(me); } //TODO: Define (Page 59)
+        constexpr uint32_t status() const { return Field<14, 1>::Get(me); } //0=Magnetic heading not available, 1=Available
+        constexpr uint32_t heading() const { return Field<15, 10>::Get(me); }
+        constexpr uint32_t type() const { return Field<25, 1>::Get(me); } //0=IAS, 1=TAS
+        constexpr uint32_t airspeed() const { return Field<26, 10>::Get(me); }
+        constexpr uint32_t vr_source() const { return Field<36, 1>::Get(me); } //Vertical Rate Source [0=GNSS, 1=Baro]
+        constexpr uint32_t vr_direction() const { return Field<37, 1>::Get(me); } //Vertical Rate Direction [0=Up, 1=Down]
+        constexpr uint32_t vertical_rate() const { return Field<38, 9>::Get(me); }
+        constexpr uint32_t gnss_sign() const { return Field<49, 1>::Get(me); } //0=Above Baro, 1=Below Baro
+        constexpr uint32_t gnss_difference() const { return Field<50, 7>::Get(me); } //Difference in altitude from baro
     };
-    static_assert(sizeof(AirSpeed) == 7);
+    static_assert(sizeof(AirSpeed) == sizeof(me_type));
 
     /*
      * Purpose: To provide a flexible means to squitter messages
      * other than position, velocity and identification.
      */
-    struct __attribute__((__packed__)) EventInfo
+    struct EventInfo
     {
-        uint64_t : 56;
+        me_type me;
     };
-    static_assert(sizeof(EventInfo) == 7);
+    static_assert(sizeof(EventInfo) == sizeof(me_type));
 
     /*
      * Purpose: To report threat aircraft state information in order
      * to improve the ability of ACAS to evaluate the threat and select
      * a resolution manoeuvre.
      */
-    struct __attribute__((__packed__)) AirToAirState
+    struct AirToAirState
     {
-        uint8_t true_airspeed_status : 1; //TODO: Find desc in docs
-        uint16_t true_airspeed : 11;      //0-2047 knots
+        me_type me;
 
-        uint8_t heading_source : 1; //0=Magnetic, 1=True Heading
-        uint8_t heading_status : 1; //TODO: Find desc in docs
-        uint8_t heading_sign : 1;   //TODO: Find desc in docs
-        uint16_t heading : 9;
+        constexpr uint32_t true_airspeed_status() const { return Field<1, 1>::Get(me); } //TODO: Find desc in docs
+        constexpr uint32_t true_airspeed() const { return Field<2, 11>::Get(me); } //0-2047 knots
 
-        uint8_t true_track_status : 1; //TODO: Find desc in docs
-        uint8_t true_track_sign : 1;   //TODO: Find desc in docs
-        uint16_t true_track : 14;
+        constexpr uint32_t heading_source() const { return Field<13, 1>::Get(me); } //0=Magnetic, 1=True Heading
+        constexpr uint32_t heading_status() const { return Field<14, 1>::Get(me); } //TODO: Find desc in docs
+        constexpr uint32_t heading_sign() const { return Field<15, 1>::Get(me); } //TODO: Find desc in docs
+        constexpr uint32_t heading() const { return Field<16, 9>::Get(me); }
 
-        uint8_t ground_speed_status : 1; //TODO: Find desc in docs
-        uint16_t ground_speed : 14;
-        uint8_t : 1; //Reserved
+        constexpr uint32_t true_track_status() const { return Field<25, 1>::Get(me); } //TODO: Find desc in docs
+        constexpr uint32_t true_track_sign() const { return Field<26, 1>::Get(me); } //TODO: Find desc in docs
+        constexpr uint32_t true_track() const { return Field<27, 14>::Get(me); }
+
+        constexpr uint32_t ground_speed_status() const { return Field<41, 1>::Get(me); } //TODO: Find desc in docs
+        constexpr uint32_t ground_speed() const { return Field<42, 14>::Get(me); }
     };
-    static_assert(sizeof(AirToAirState) == 7);
+    static_assert(sizeof(AirToAirState) == sizeof(me_type));
 
     /*
      * Purpose: To report threat aircraft state information in order to
      * improve the ability of ACAS to evaluate the threat and select
      * a resolution maneuver.
      */
-    struct __attribute__((__packed__)) AirToAirIntent
+    struct AirToAirIntent
     {
-        uint8_t altitude_status : 1; //TODO: Find desc in docs
-        uint16_t altitude : 12;      //0-65,520 ft
+        me_type me;
 
-        uint8_t next_course_status : 1; //TODO: Find desc in docs
-        uint8_t next_course_sign : 1;   //TODO: Find desc in docs
-        uint16_t next_course : 9;       // +/- 180 deg
+        constexpr uint32_t altitude_status() const { return Field<1, 1>::Get(me); } //TODO: Find desc in docs
+        constexpr uint32_t altitude() const { return Field<2, 12>::Get(me); } //0-65,520 ft
 
-        uint8_t time_to_next_waypoint_status : 1; //TODO: Find desc in docs
-        uint16_t time_to_next_waypoint : 9;       //0-256 seconds
+        constexpr uint32_t next_course_status() const { return Field<14, 1>::Get(me); } //TODO: Find desc in docs
+        constexpr uint32_t next_course_sign() const { return Field<15, 1>::Get(me); } //TODO: Find desc in docs
+        constexpr uint32_t next_course() const { return Field<16, 9>::Get(me); } //+/- 180 deg
 
-        uint8_t vertical_velocity_status : 1; //TODO: Find desc in docs
-        uint8_t vertical_velocity_sign : 1;   //TODO: Find desc in docs
-        int8_t vertical_velocity : 8;         //Starting from 64 ft/min (*32 ft/min)
+        constexpr uint32_t time_to_next_waypoint_status() const { return Field<25, 1>::Get(me); } //TODO: Find desc in docs
+        constexpr uint32_t time_to_next_waypoint() const { return Field<26, 9>::Get(me); } //0-256 seconds
 
-        uint8_t roll_angle_status : 1; //TODO: Find desc in docs
-        uint8_t roll_angle_sign : 1;   //TODO: Find desc in docs
-        int8_t roll_angle : 7;  //Starting from 64 ft/min (*32 ft/min)
+        constexpr uint32_t vertical_velocity_status() const { return Field<35, 1>::Get(me); } //TODO: Find desc in docs
+        constexpr uint32_t vertical_velocity_sign() const { return Field<36, 1>::Get(me); } //TODO: Find desc in docs
+        constexpr uint32_t vertical_velocity() const { return Field<37, 8>::Get(me); } //Starting from 64 ft/min (*32 ft/min)
 
-        uint8_t : 3; //Reserved
+        constexpr uint32_t roll_angle_status() const { return Field<45, 1>::Get(me); } //TODO: Find desc in docs
+        constexpr uint32_t roll_angle_sign() const { return Field<46, 1>::Get(me); } //TODO: Find desc in docs
+        constexpr uint32_t roll_angle() const { return Field<47, 7>::Get(me); }
     };
-    static_assert(sizeof(AirToAirIntent) == 7);
+    static_assert(sizeof(AirToAirIntent) == sizeof(me_type));
 
     /*
      * Purpose: To report the data link capability of the Mode S
      * transponder/data link installation.
      */
-    struct __attribute__((__packed__)) DataLinkCapability
+    struct DataLinkCapability
     {
-        uint8_t bds_code : 8;
-        uint8_t continuation : 1;
-        uint8_t : 5;           //reserved
-        uint8_t occ_flag : 1;  //Overlay Command Capability [0=no, 1=yes]
-        uint8_t acas_flag : 1; //1=ACAS is active, 0=disabled/standby
+        me_type me;
+
+        constexpr uint32_t bds_code() const { return Field<1, 8>::Get(me); }
+        constexpr uint32_t continuation() const { return Field<9, 1>::Get(me); }
+        /* 10-14: reserved */
+        constexpr uint32_t occ_flag() const { return Field<15, 1>::Get(me); }  //Overlay Command Capability [0=no, 1=yes]
+        constexpr uint32_t acas_flag() const { return Field<16, 1>::Get(me); } //1=ACAS is active, 0=disabled/standby
 
         /* ModeS Version numbers
          * 0 = No ModeS
@@ -204,19 +217,19 @@ namespace ssr::ads_b::es
          * 5 = ICAO Doc.9871, Edition 2
          * 6-127 = Reserved
          */
-        uint8_t modes_version : 7;
+        constexpr uint32_t modes_version() const { return Field<17, 7>::Get(me); }
 
         /* The enhanced protocol indicator shall denote a Level 5 transponder
          * when set to 1, and a Level 2 to 4 transponder when set to 0.
          */
-        uint8_t enhanced_flag : 1;
+        constexpr uint32_t enhanced_flag() const { return Field<24, 1>::Get(me); }
 
         /* When this is set to 1, it shall indicate that at least one Mode S
          * specific service (other than GICB services related to 
          * registers 02, 03, 04, 10, 17-1C, 20 and 30) is supported and the
          * particular capability reports shall be checked.
          */
-        uint8_t modes_flag : 1;
+        constexpr uint32_t modes_flag() const { return Field<25, 1>::Get(me); }
 
         /* Uplink ELM average throughput capability shall be coded as follows:
          * 0 = No UELM Capability
@@ -228,7 +241,7 @@ namespace ssr::ads_b::es
          * 6 = 16 UELM segments in 30 ms
          * 7 = Reserved
          */
-        uint8_t elm_uplink_throughput : 3;
+        constexpr uint32_t elm_uplink_throughput() const { return Field<26, 3>::Get(me); }
 
         /* Downlink ELM throughput capability shall be coded as follows:
          * 0 = No DELM Capability
@@ -240,32 +253,32 @@ namespace ssr::ads_b::es
          * 6 = One 16 segment DELM every 125 ms
          * 7-15 = Reserved
          */
-        uint8_t elm_downlink_throughput : 4;
+        constexpr uint32_t elm_downlink_throughput() const { return Field<29, 4>::Get(me); }
 
         /* Indicates the availability of Aircraft Identification data. It shall be set by the
          * transponder if the data comes to the transponder through a separate interface and
          * not through the ADLP.
          */
-        uint8_t ident_capability : 1;
+        constexpr uint32_t ident_capability() const { return Field<33, 1>::Get(me); }
 
         /* The squitter capability subfield (SCS) shall be set to 1 if both registers
          * [0x05] and [0x06] have been updated within the last ten, plus or minus
          * one, seconds. Otherwise, it shall be set to 0.
          */
-        uint8_t scs_flag : 1;
+        constexpr uint32_t scs_flag() const { return Field<34, 1>::Get(me); }
 
         /* The surveillance identifier code (SIC) bit shall be interpreted as follows:
          * 0 = no surveillance identifier code capability
          * 1 = surveillance identifier code capability
          */
-        uint8_t sic_flag : 1;
+        constexpr uint32_t sic_flag() const { return Field<35, 1>::Get(me); }
 
         /* This shall be toggled each time the common usage GICB capability
          * report (register [0x17]) changes. To avoid the generation of too many
          * broadcast capability report changes, register [0x17] shall be sampled at
          * approximately one minute intervals to check for changes.
          */
-        uint8_t gicb_flag : 1;
+        constexpr uint32_t gicb_flag() const { return Field<36, 1>::Get(me); }
 
         /* Bit 0 shall be set to ONE (1) to indicate the capability of hybrid surveillance,
          * and set to ZERO (0) to indicate that there is no hybrid surveillance capability.
@@ -278,7 +291,7 @@ namespace ssr::ads_b::es
          * 
          * Bit 4 TCAS-B ??
          */
-        uint8_t acas_capability : 4;
+        constexpr uint32_t acas_capability() const { return Field<37, 4>::Get(me); }
 
         /* 
          * Starting from the MSB, each subsequent bit position shall represent
@@ -289,9 +302,9 @@ namespace ssr::ads_b::es
          * in a broadcast of the capability report, status inputs shall be sampled
          * at approximately one minute intervals.
          */
-        uint16_t dte_flags : 16;
+        constexpr uint32_t dte_flags() const { return Field<41, 16>::Get(me); }
     };
-    static_assert(sizeof(DataLinkCapability) == 7);
+    static_assert(sizeof(DataLinkCapability) == sizeof(me_type));
 
     /*
      * Purpose: To indicate common usage GICB services currently
@@ -300,56 +313,60 @@ namespace ssr::ads_b::es
      * Each bit position shall indicate that the associated register is
      * available in the aircraft installation when set to 1.
      */
-    struct __attribute__((__packed__)) GICBCommonReport
+    struct GICBCommonReport
     {
-        uint8_t es_airborne_position : 1;
-        uint8_t es_surface_position : 1;
-        uint8_t es_status : 1;
-        uint8_t es_ident_and_category : 1;
-        uint8_t es_airborne_velocity : 1;
-        uint8_t es_event_driven_info : 1;
-        uint8_t identification : 1;
-        uint8_t registration : 1;
-
-        uint8_t vertical_intention : 1;
-        uint8_t next_waypoint_identifier : 1;
-        uint8_t next_waypoint_position : 1;
-        uint8_t next_waypoint_information : 1;
-        uint8_t meterological_routine_report : 1;
-        uint8_t meterological_hazard_report : 1;
-        uint8_t vhf_channel_report : 1;
-        uint8_t track_and_turn_report : 1;
-
-        uint8_t position_coarse : 1;
-        uint8_t position_fine : 1;
-        uint8_t air_referenced_state_vector : 1;
-        uint8_t waypoint_1 : 1;
-        uint8_t waypoint_2 : 1;
-        uint8_t waypoint_3 : 1;
-        uint8_t quasi_static_parameter_monitoring : 1;
-        uint8_t heading_and_speed_report : 1;
-
-        uint8_t : 2; //Reserved for aircraft capability
-        uint8_t : 2; //Reserved for ModeS BITE (Built In Test Equipment)
-        uint32_t military_applications : 28;
+        me_type me;
+
+        constexpr uint32_t es_airborne_position() const { return Field<1, 1>::Get(me); }
+        constexpr uint32_t es_surface_position() const { return Field<2, 1>::Get(me); }
+        constexpr uint32_t es_status() const { return Field<3, 1>::Get(me); }
+        constexpr uint32_t es_ident_and_category() const { return Field<4, 1>::Get(me); }
+        constexpr uint32_t es_airborne_velocity() const { return Field<5, 1>::Get(me); }
+        constexpr uint32_t es_event_driven_info() const { return Field<6, 1>::Get(me); }
+        constexpr uint32_t identification() const { return Field<7, 1>::Get(me); }
+        constexpr uint32_t registration() const { return Field<8, 1>::Get(me); }
+
+        constexpr uint32_t vertical_intention() const { return Field<9, 1>::Get(me); }
+        constexpr uint32_t next_waypoint_identifier() const { return Field<10, 1>::Get(me); }
+        constexpr uint32_t next_waypoint_position() const { return Field<11, 1>::Get(me); }
+        constexpr uint32_t next_waypoint_information() const { return Field<12, 1>::Get(me); }
+        constexpr uint32_t meterological_routine_report() const { return Field<13, 1>::Get(me); }
+        constexpr uint32_t meterological_hazard_report() const { return Field<14, 1>::Get(me); }
+        constexpr uint32_t vhf_channel_report() const { return Field<15, 1>::Get(me); }
+        constexpr uint32_t track_and_turn_report() const { return Field<16, 1>::Get(me); }
+
+        constexpr uint32_t position_coarse() const { return Field<17, 1>::Get(me); }
+        constexpr uint32_t position_fine() const { return Field<18, 1>::Get(me); }
+        constexpr uint32_t air_referenced_state_vector() const { return Field<19, 1>::Get(me); }
+        constexpr uint32_t waypoint_1() const { return Field<20, 1>::Get(me); }
+        constexpr uint32_t waypoint_2() const { return Field<21, 1>::Get(me); }
+        constexpr uint32_t waypoint_3() const { return Field<22, 1>::Get(me); }
+        constexpr uint32_t quasi_static_parameter_monitoring() const { return Field<23, 1>::Get(me); }
+        constexpr uint32_t heading_and_speed_report() const { return Field<24, 1>::Get(me); }
+
+        /* 25-26: Reserved for aircraft capability */
+        /* 27-28: Reserved for ModeS BITE (Built In Test Equipment) */
+        constexpr uint32_t military_applications() const { return Field<29, 28>::Get(me); }
     };
-    static_assert(sizeof(GICBCommonReport) == 7);
+    static_assert(sizeof(GICBCommonReport) == sizeof(me_type));
 
     /*
      * Purpose: To report aircraft identification to the ground.
      */
-    struct __attribute__((__packed__)) Identification
+    struct Identification
     {
-        uint8_t : 8;
-        char char_1 : 6;
-        char char_2 : 6;
-        char char_3 : 6;
-        char char_4 : 6;
-        char char_5 : 6;
-        char char_6 : 6;
-        char char_7 : 6;
-        char char_8 : 6;
+        me_type me;
+
+        constexpr uint32_t bds_code() const { return Field<1, 8>::Get(me); }
+        constexpr uint32_t char_1() const { return Field<9, 6>::Get(me); }
+        constexpr uint32_t char_2() const { return Field<15, 6>::Get(me); }
+        constexpr uint32_t char_3() const { return Field<21, 6>::Get(me); }
+        constexpr uint32_t char_4() const { return Field<27, 6>::Get(me); }
+        constexpr uint32_t char_5() const { return Field<33, 6>::Get(me); }
+        constexpr uint32_t char_6() const { return Field<39, 6>::Get(me); }
+        constexpr uint32_t char_7() const { return Field<45, 6>::Get(me); }
+        constexpr uint32_t char_8() const { return Field<51, 6>::Get(me); }
     };
-    static_assert(sizeof(Identification) == 7);
+    static_assert(sizeof(Identification) == sizeof(me_type));
 
 } // namespace ssr::ads_b::es
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <stdint.h>
+#include <memory>
+
+#include <ads-b/registers.hpp>
+#include <ads-b/batch.hpp>
+#include <ads-b/cpr.hpp>
+
+namespace ssr::ads_b
+{
+    /* State kept for every aircraft heard, aligned to cache lines. */
+    struct alignas(64) Aircraft {
+        uint32_t icao;      /* 24 bit ICAO address, 0 = free slot */
+        uint32_t seen;      /* Last update, loop time in ms */
+        uint32_t messages;  /* Messages received */
+        Registers registers; /* Last value of every register heard */
+
+        /* CPR decoding state, index 0 is the last even and 1 the last odd
+         * airborne position message. */
+        uint8_t cpr_valid;  /* Bit 0/1 set when cpr_*[0/1] is filled */
+        uint8_t has_position;
+        uint32_t cpr_lat[2], cpr_lon[2];
+        uint32_t cpr_time[2];
+
+        double lat, lon;        /* Last decoded position */
+        uint32_t position_time; /* When lat/lon were decoded */
+    };
+    static_assert(sizeof(Aircraft) == 192);
+
+    /* What AircraftTable::Update() did with a message */
+    struct AircraftUpdate {
+        Aircraft *aircraft; /* nullptr when the address is not tracked */
+        bool position;      /* The message resolved aircraft->lat/lon */
+    };
+
+    /* Table of aircraft keyed by ICAO address.
+     *
+     * Open addressed with linear probing in a fixed power of two array
+     * allocated up front, so lookups are O(1) and updates never allocate.
+     * Aircraft not heard from for 'ttlMs' are removed incrementally by
+     * Expire() using backward shift deletion, so no tombstones build up.
+     */
+    class AircraftTable {
+    public:
+        /* Max age of the other half of an even/odd pair for global decoding */
+        static constexpr uint32_t CPRPairMs = 10 * 1000;
+        /* Max age of a position used as reference for local decoding */
+        static constexpr uint32_t LocalReferenceMs = 30 * 1000;
+
+        AircraftTable(uint32_t capacity, uint32_t ttlMs) : _ttl(ttlMs) {
+            _size = 1;
+            while (_size < capacity)
+                _size <<= 1;
+            _entries = std::make_unique<Aircraft[]>(_size);
+        }
+
+        /* Returns the entry for 'icao', or nullptr if not tracked */
+        Aircraft *Find(uint32_t icao) const {
+            for (uint32_t h = hash(icao);; h = (h + 1) & (_size - 1)) {
+                Aircraft &a = _entries[h];
+                if (a.icao == icao)
+                    return &a;
+                if (a.icao == 0)
+                    return nullptr;
+            }
+        }
+
+        /* Returns the entry for 'icao', creating it if needed. Returns
+         * nullptr only when the table is full. */
+        Aircraft *Get(uint32_t icao, uint32_t now) {
+            for (uint32_t h = hash(icao);; h = (h + 1) & (_size - 1)) {
+                Aircraft &a = _entries[h];
+                if (a.icao == icao)
+                    return &a;
+                if (a.icao == 0) {
+                    if (_count >= _size - (_size >> 3))
+                        return nullptr; /* Keep probe chains short */
+                    a = Aircraft{};
+                    a.icao = icao;
+                    a.seen = now;
+                    _count++;
+                    return &a;
+                }
+            }
+        }
+
+        /* Update the aircraft of row 'i' of a batch. Only call this for
+         * messages with a valid CRC. */
+        AircraftUpdate Update(const transport::MessageBatch &batch, size_t i, uint32_t now) {
+            uint32_t icao = batch.icao[i];
+            if (icao == 0)
+                return {nullptr, false};
+
+            /* DF18 also carries TIS-B and ADS-R, whose address may be
+             * anonymous or non-ICAO and would share an entry with an
+             * unrelated aircraft. Only CF=0 is sure to be an ICAO address. */
+            if (batch.df[i] == 18 && batch.ca[i] != 0)
+                return {nullptr, false};
+
+            Aircraft *a = Get(icao, now);
+            if (!a)
+                return {nullptr, false};
+
+            a->seen = now;
+            a->messages++;
+
+            bool position = false;
+            switch (batch.df[i]) {
+            case 17:
+            case 18: {
+                uint8_t reg = Registers::ForTypeCode(batch.metype[i]);
+                if (reg)
+                    a->registers.Set(reg, batch.Frame(i).Data56());
+                if (reg == Registers::ES_AirbornePosition)
+                    position = updatePosition(*a, batch, i, now);
+                break;
+            }
+            case 20:
+            case 21: {
+                /* The BDS of a Comm-B reply is only known to the interrogator,
+                 * these two registers carry it in their first byte. */
+                uint64_t mb = batch.Frame(i).Data56();
+                uint8_t bds = mb >> 48;
+                if (bds == Registers::DataLinkCapability || bds == Registers::Identification)
+                    a->registers.Set(bds, mb);
+                break;
+            }
+            }
+            return {a, position};
+        }
+
+        /* Remove aircraft not heard from in 'ttlMs', checking at most
+         * 'slots' entries per call so the work is spread out. */
+        void Expire(uint32_t now, uint32_t slots = 1024) {
+            for (uint32_t n = 0; n < slots; n++) {
+                Aircraft &a = _entries[_cursor];
+                if (a.icao != 0 && now - a.seen > _ttl) {
+                    remove(_cursor);
+                    continue; /* Slot may now hold a shifted entry */
+                }
+                _cursor = (_cursor + 1) & (_size - 1);
+            }
+        }
+
+        size_t Count() const { return _count; }
+        uint32_t Capacity() const { return _size; }
+
+    private:
+        uint32_t hash(uint32_t a) const {
+            a = ((a >> 16) ^ a) * 0x45d9f3b;
+            a = ((a >> 16) ^ a) * 0x45d9f3b;
+            a = ((a >> 16) ^ a);
+            return a & (_size - 1);
+        }
+
+        /* Resolve the CPR position of an airborne position message. A fresh
+         * even/odd pair gives a global decode, otherwise a recent position
+         * of the same aircraft is used as the reference for a local one.
+         * Returns true when a position was resolved. */
+        bool updatePosition(Aircraft &a, const transport::MessageBatch &batch, size_t i, uint32_t now) {
+            int odd = batch.fflag[i] ? 1 : 0;
+            double lat, lon;
+            bool ok = false;
+
+            a.cpr_lat[odd] = batch.raw_latitude[i];
+            a.cpr_lon[odd] = batch.raw_longitude[i];
+            a.cpr_time[odd] = now;
+            a.cpr_valid |= 1 << odd;
+
+            if (a.cpr_valid == 3 && now - a.cpr_time[!odd] <= CPRPairMs) {
+                ok = cpr::DecodeGlobal(a.cpr_lat[0], a.cpr_lon[0], a.cpr_lat[1], a.cpr_lon[1], odd, lat, lon);
+            }
+            if (!ok && a.has_position && now - a.position_time <= LocalReferenceMs) {
+                cpr::DecodeLocal(a.cpr_lat[odd], a.cpr_lon[odd], odd, a.lat, a.lon, lat, lon);
+                ok = true;
+            }
+            if (ok) {
+                a.lat = lat;
+                a.lon = lon;
+                a.position_time = now;
+                a.has_position = 1;
+            }
+            return ok;
+        }
+
+        /* Backward shift deletion: move later entries of the probe chain
+         * into the hole so lookups never need tombstones. */
+        void remove(uint32_t hole) {
+            uint32_t j = hole;
+            for (;;) {
+                j = (j + 1) & (_size - 1);
+                if (_entries[j].icao == 0)
+                    break;
+                uint32_t home = hash(_entries[j].icao);
+                /* Move j into the hole unless its home lies in (hole, j] */
+                bool stays = hole <= j ? (hole < home && home <= j) : (hole < home || home <= j);
+                if (!stays) {
+                    _entries[hole] = _entries[j];
+                    hole = j;
+                }
+            }
+            _entries[hole].icao = 0;
+            _count--;
+        }
+
+        uint32_t _ttl;
+        uint32_t _size;
+        uint32_t _count = 0;
+        uint32_t _cursor = 0;
+        std::unique_ptr<Aircraft[]> _entries;
+    };
+
+} // namespace ssr::ads_b
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <array>
+
+namespace ssr::ads_b::transport
+{
+    /* The 13 bit AC and ID fields interleave the Mode A/C pulses like
+     * that (message bit 20 to bit 32):
+     *
+     * C1-A1-C2-A2-C4-A4-M/X-B1-Q/D1-B2-D2-B4-D4
+     *
+     * Returns the pulses as 0xABCD, every hex digit being the octal digit
+     * of one group (A4 A2 A1 and so on), which is how a squawk reads. */
+    static constexpr uint32_t ModeAPulses(uint32_t field)
+    {
+        constexpr uint8_t pulse[13] = {
+            /* D4, B4, D2, B2, D1, B1, M/X, A4, C4, A2, C2, A1, C1 */
+            2, 10, 1, 9, 0, 8, 0xFF, 14, 6, 13, 5, 12, 4};
+        uint32_t a = 0;
+        for (int i = 0; i < 13; i++)
+        {
+            if (pulse[i] != 0xFF && (field & (1 << i)))
+                a |= 1u << pulse[i];
+        }
+        return a;
+    }
+
+    /* Altitude in feet of the Gillham coded pulses 0xABCD, or 0 when the
+     * code is not a valid altitude. The 500 ft steps are a Gray code over
+     * D2 D4 A1 A2 A4 B1 B2 B4, the 100 ft steps a reflected code over
+     * C1 C2 C4, running backwards when the 500 ft count is odd.
+     *
+     * For more info: http://en.wikipedia.org/wiki/Gillham_code */
+    static constexpr int GillhamAltitude(uint32_t pulses)
+    {
+        /* D1 is never used for altitude and C1..C4 are never all zero */
+        if ((pulses & 0x8889) != 0 || (pulses & 0x00F0) == 0)
+            return 0;
+
+        int hundreds = 0;
+        if (pulses & 0x0010)
+            hundreds ^= 7; /* C1 */
+        if (pulses & 0x0020)
+            hundreds ^= 3; /* C2 */
+        if (pulses & 0x0040)
+            hundreds ^= 1; /* C4 */
+        if ((hundreds & 5) == 5)
+            hundreds ^= 2; /* Swap 5 and 7 */
+        if (hundreds > 5)
+            return 0;
+
+        int fiveHundreds = 0;
+        if (pulses & 0x0002)
+            fiveHundreds ^= 0xFF; /* D2 */
+        if (pulses & 0x0004)
+            fiveHundreds ^= 0x7F; /* D4 */
+        if (pulses & 0x1000)
+            fiveHundreds ^= 0x3F; /* A1 */
+        if (pulses & 0x2000)
+            fiveHundreds ^= 0x1F; /* A2 */
+        if (pulses & 0x4000)
+            fiveHundreds ^= 0x0F; /* A4 */
+        if (pulses & 0x0100)
+            fiveHundreds ^= 0x07; /* B1 */
+        if (pulses & 0x0200)
+            fiveHundreds ^= 0x03; /* B2 */
+        if (pulses & 0x0400)
+            fiveHundreds ^= 0x01; /* B4 */
+
+        if (fiveHundreds & 1)
+            hundreds = 6 - hundreds;
+
+        return (fiveHundreds * 5 + hundreds - 13) * 100;
+    }
+
+    /* Altitude in feet of a 13 bit AC field, 0 if it can't be decoded.
+     *
+     * With Q=1 the 11 bits left after removing M and Q count 25 ft steps
+     * from -1000 ft, with Q=0 the field holds the Gillham code of the Mode
+     * C reply in 100 ft steps. M=1 flags a metric altitude, whose coding
+     * the standard leaves undefined, those return 0. */
+    static constexpr int AC13Altitude(uint32_t field)
+    {
+        if (field & 0x40)
+            return 0;
+        if (field & 0x10)
+        {
+            int n = ((field & 0x1F80) >> 2) | ((field & 0x20) >> 1) | (field & 0xF);
+            return n * 25 - 1000;
+        }
+        return GillhamAltitude(ModeAPulses(field));
+    }
+
+    /* Squawk of a 13 bit ID field as a decimal number reading like the
+     * four octal digits, e.g. 7700. */
+    static constexpr int ID13Squawk(uint32_t field)
+    {
+        uint32_t a = ModeAPulses(field);
+        return ((a >> 12) & 7) * 1000 + ((a >> 8) & 7) * 100 + ((a >> 4) & 7) * 10 + (a & 7);
+    }
+
+    template <class T, size_t Size, class TFn>
+    static constexpr std::array<T, Size> MakeFieldTable(TFn fn)
+    {
+        std::array<T, Size> t{};
+        for (size_t i = 0; i < Size; i++)
+            t[i] = fn(i);
+        return t;
+    }
+
+    /* Precomputed decodes of the altitude and identity fields, indexed
+     * by the raw field so decoding one is a single load. */
+    class AltitudeCode
+    {
+    public:
+        /* 13 bit AC field of DF0/4/16/20, feet */
+        static constexpr std::array<int32_t, 1 << 13> AC13 = MakeFieldTable<int32_t, 1 << 13>([](uint32_t f) {
+            return (int32_t)AC13Altitude(f);
+        });
+
+        /* 12 bit AC field of airborne position squitters, which is the AC13
+         * field without the M bit, feet */
+        static constexpr std::array<int32_t, 1 << 12> AC12 = MakeFieldTable<int32_t, 1 << 12>([](uint32_t f) {
+            return (int32_t)AC13Altitude(((f & 0xFC0) << 1) | (f & 0x3F));
+        });
+
+        /* 13 bit ID field of DF5/21 */
+        static constexpr std::array<uint16_t, 1 << 13> ID13 = MakeFieldTable<uint16_t, 1 << 13>([](uint32_t f) {
+            return (uint16_t)ID13Squawk(f);
+        });
+
+        static constexpr bool IsMetric(uint32_t ac13) { return ac13 & 0x40; }
+    };
+
+    /* C4 alone is the lowest Gillham altitude, C2 the next 500 ft step */
+    static_assert(GillhamAltitude(0x0040) == -1200);
+    static_assert(GillhamAltitude(0x0020) == -1000);
+    static_assert(ID13Squawk(0x1FBF) == 7777);
+
+} // namespace ssr::ads_b::transport
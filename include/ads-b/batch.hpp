@@ -0,0 +1,121 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <memory.h>
+
+#include <ads-b/frame.hpp>
+
+#define MODES_BATCH_SIZE 256
+
+namespace ssr::ads_b::transport
+{
+    /* A raw Mode S frame as handed over by an input port. */
+    struct RawFrame
+    {
+        unsigned char data[14]; /* Binary message, short frames use 7 bytes */
+        uint8_t len;            /* Number of bytes in data */
+        uint8_t signal;         /* Signal level, 0 if unknown */
+        uint64_t timestamp;     /* 48 bit MLAT timestamp, 0 if unknown */
+        uint64_t time;          /* Receive time on the local clock in us, see ClockSync */
+        uint32_t source;        /* Feeder the frame came from */
+        uint32_t syndrome;      /* Checksum xor parity after correction, valid if 'checked' */
+        int16_t errorbit;       /* Bits fixed in 'data', see modesMessage::errorbit */
+        uint8_t checked = 0;    /* Set once Mixer::route() checked the CRC and corrected 'data' */
+    };
+
+    /* Decoded messages stored column by column.
+     *
+     * Row 'i' of every column belongs to the same message, so later stages
+     * can loop over just the columns they need. All storage is inline, a
+     * batch is allocated once and reused.
+     */
+    struct MessageBatch
+    {
+        static constexpr size_t Capacity = MODES_BATCH_SIZE;
+
+        size_t size = 0;
+
+        /* Generic fields */
+        unsigned char msg[Capacity][14]; /* Binary message, after error correction */
+        uint8_t msgbits[Capacity];       /* Number of bits in message */
+        uint8_t df[Capacity];            /* Downlink format # */
+        uint8_t ca[Capacity];            /* Responder capabilities / flight status */
+        uint32_t icao[Capacity];         /* ICAO address (recovered for AP formats) */
+        uint8_t crcok[Capacity];         /* True if CRC was valid */
+        int16_t errorbit[Capacity];      /* Bit(s) corrected, -1 if none */
+
+        /* Receiver metadata */
+        uint64_t timestamp[Capacity];
+        uint8_t signal[Capacity];
+        uint64_t time[Capacity];   /* Receive time on the local clock in us */
+        uint32_t source[Capacity]; /* Feeder */
+
+        /* DF 17 */
+        uint8_t metype[Capacity];
+        uint8_t mesub[Capacity];
+        uint8_t fflag[Capacity];
+        uint32_t raw_latitude[Capacity];
+        uint32_t raw_longitude[Capacity];
+        char flight[Capacity][9];
+        int16_t velocity[Capacity];
+        int16_t heading[Capacity];
+        uint8_t velocity_valid[Capacity]; /* 0 when the message has no speed */
+        uint8_t heading_valid[Capacity];  /* 0 when the message has no track/heading */
+        int16_t vert_rate[Capacity]; /* ft/min, negative when descending */
+
+        /* Fields used by multiple message types */
+        int32_t altitude[Capacity];
+        uint8_t unit[Capacity];
+        uint16_t identity[Capacity]; /* Squawk */
+
+        /* Position resolved by the worker for airborne position messages,
+         * lat/lon are only set when 'position' is */
+        uint8_t position[Capacity];
+        double lat[Capacity];
+        double lon[Capacity];
+
+        /* Raw view of row 'i' */
+        ModeSFrame Frame(size_t i) const { return ModeSFrame(msg[i], msgbits[i] / 8); }
+
+        bool Full() const { return size == Capacity; }
+        void Clear() { size = 0; }
+
+        /* Copy row 'i' of 'src' to row 'j' */
+        void SetRow(size_t j, const MessageBatch &src, size_t i)
+        {
+            memcpy(msg[j], src.msg[i], sizeof(src.msg[i]));
+            msgbits[j] = src.msgbits[i];
+            df[j] = src.df[i];
+            ca[j] = src.ca[i];
+            icao[j] = src.icao[i];
+            crcok[j] = src.crcok[i];
+            errorbit[j] = src.errorbit[i];
+            timestamp[j] = src.timestamp[i];
+            signal[j] = src.signal[i];
+            time[j] = src.time[i];
+            source[j] = src.source[i];
+            metype[j] = src.metype[i];
+            mesub[j] = src.mesub[i];
+            fflag[j] = src.fflag[i];
+            raw_latitude[j] = src.raw_latitude[i];
+            raw_longitude[j] = src.raw_longitude[i];
+            memcpy(flight[j], src.flight[i], sizeof(src.flight[i]));
+            velocity[j] = src.velocity[i];
+            heading[j] = src.heading[i];
+            velocity_valid[j] = src.velocity_valid[i];
+            heading_valid[j] = src.heading_valid[i];
+            vert_rate[j] = src.vert_rate[i];
+            altitude[j] = src.altitude[i];
+            unit[j] = src.unit[i];
+            identity[j] = src.identity[i];
+            position[j] = src.position[i];
+            lat[j] = src.lat[i];
+            lon[j] = src.lon[i];
+        }
+
+        /* Append row 'i' of 'src', the batch must not be full */
+        void Append(const MessageBatch &src, size_t i) { SetRow(size++, src, i); }
+    };
+
+} // namespace ssr::ads_b::transport
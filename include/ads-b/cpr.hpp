@@ -0,0 +1,121 @@
+#pragma once
+
+#include <stdint.h>
+#include <cmath>
+
+namespace ssr::ads_b::cpr
+{
+    /* Latitudes at which the number of longitude zones (NL) drops by one,
+     * from the NL equation of the 1090 MHz MOPS (DO-260B A.1.7.2). NL is 59
+     * below the first entry and drops at every entry, except at the last
+     * where it stays 2 up to and including 87 degrees and is 1 above. */
+    static constexpr double nl_transitions[58] = {
+        10.47047130, 14.82817437, 18.18626357, 21.02939493, 23.54504487, 25.82924707,
+        27.93898710, 29.91135686, 31.77209708, 33.53993436, 35.22899598, 36.85025108,
+        38.41241892, 39.92256684, 41.38651832, 42.80914012, 44.19454951, 45.54626723,
+        46.86733252, 48.16039128, 49.42776439, 50.67150166, 51.89342469, 53.09516153,
+        54.27817472, 55.44378444, 56.59318756, 57.72747354, 58.84763776, 59.95459277,
+        61.04917774, 62.13216659, 63.20427479, 64.26616523, 65.31845310, 66.36171008,
+        67.39646774, 68.42322022, 69.44242631, 70.45451075, 71.45986473, 72.45884545,
+        73.45177442, 74.43893416, 75.42056257, 76.39684391, 77.36789461, 78.33374083,
+        79.29428225, 80.24923213, 81.19801349, 82.13956981, 83.07199445, 83.99173563,
+        84.89166191, 85.75541621, 86.53536998, 87.00000000};
+
+    /* Number of longitude zones at 'lat', a table lookup instead of the
+     * acos/cos of the NL equation. */
+    static constexpr int NL(double lat)
+    {
+        if (lat < 0)
+            lat = -lat;
+        if (lat > 87.0)
+            return 1;
+
+        /* Binary search for the number of transitions at or below lat */
+        int lo = 0, hi = 57;
+        while (lo < hi)
+        {
+            int mid = (lo + hi) / 2;
+            if (nl_transitions[mid] <= lat)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return 59 - lo;
+    }
+    static_assert(NL(0) == 59 && NL(52.2572) == 36 && NL(-87.1) == 1);
+    static_assert(NL(87.0) == 2 && NL(-87.0) == 2 && NL(86.9) == 2 && NL(87.00001) == 1);
+    static_assert(NL(86.53536998) == 2 && NL(86.5) == 3);
+
+    static constexpr double AirDlat0 = 360.0 / 60;
+    static constexpr double AirDlat1 = 360.0 / 59;
+    static constexpr double Scale = 131072.0; /* 2^17 */
+
+    /* Always positive modulo */
+    static constexpr int modInt(int a, int b)
+    {
+        int res = a % b;
+        return res < 0 ? res + b : res;
+    }
+
+    static inline double modDouble(double a, double b)
+    {
+        double res = std::fmod(a, b);
+        return res < 0 ? res + b : res;
+    }
+
+    /* Global airborne decode from an even and an odd message received
+     * within 10 seconds of each other. 'odd_latest' selects which of the two
+     * the position is computed for. Returns false if the two messages are
+     * in different latitude zones. */
+    static inline bool DecodeGlobal(uint32_t lat0, uint32_t lon0, uint32_t lat1, uint32_t lon1,
+                                    bool odd_latest, double &lat, double &lon)
+    {
+        int j = (int)std::floor(((59.0 * lat0 - 60.0 * lat1) / Scale) + 0.5);
+        double rlat0 = AirDlat0 * (modInt(j, 60) + lat0 / Scale);
+        double rlat1 = AirDlat1 * (modInt(j, 59) + lat1 / Scale);
+
+        if (rlat0 >= 270)
+            rlat0 -= 360;
+        if (rlat1 >= 270)
+            rlat1 -= 360;
+        if (rlat0 < -90 || rlat0 > 90 || rlat1 < -90 || rlat1 > 90)
+            return false;
+
+        int nl = NL(rlat0);
+        if (nl != NL(rlat1))
+            return false;
+
+        int m = (int)std::floor((((double)lon0 * (nl - 1)) - ((double)lon1 * nl)) / Scale + 0.5);
+        int ni = odd_latest ? nl - 1 : nl;
+        if (ni < 1)
+            ni = 1;
+
+        lat = odd_latest ? rlat1 : rlat0;
+        lon = (360.0 / ni) * (modInt(m, ni) + (odd_latest ? lon1 : lon0) / Scale);
+        if (lon > 180)
+            lon -= 360;
+        return true;
+    }
+
+    /* Local airborne decode of a single message relative to a reference
+     * position less than 180 NM away, such as the last known position. */
+    static inline void DecodeLocal(uint32_t rawlat, uint32_t rawlon, bool odd, double reflat, double reflon,
+                                   double &lat, double &lon)
+    {
+        double dlat = odd ? AirDlat1 : AirDlat0;
+        double j = std::floor(reflat / dlat) +
+                   std::floor(0.5 + modDouble(reflat, dlat) / dlat - rawlat / Scale + 1e-9);
+
+        lat = dlat * (j + rawlat / Scale);
+
+        int ni = NL(lat) - (odd ? 1 : 0);
+        if (ni < 1)
+            ni = 1;
+        double dlon = 360.0 / ni;
+        double m = std::floor(reflon / dlon) +
+                   std::floor(0.5 + modDouble(reflon, dlon) / dlon - rawlon / Scale + 1e-9);
+
+        lon = dlon * (m + rawlon / Scale);
+    }
+
+} // namespace ssr::ads_b::cpr
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <stdint.h>
+#include <array>
+
+namespace ssr::ads_b::transport
+{
+    /* Byte-wise lookup table for an MSB-first 24 bit CRC */
+    template <uint32_t Poly>
+    static constexpr std::array<uint32_t, 256> MakeCRC24Table()
+    {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t c = i << 16;
+            for (int b = 0; b < 8; b++)
+                c = (c & 0x800000) ? ((c << 1) ^ Poly) : (c << 1);
+            t[i] = c & 0xFFFFFF;
+        }
+        return t;
+    }
+
+    /* Mode S CRC-24 (generator polynomial 0x1FFF409).
+     *
+     * The parity field of a Mode S message is the remainder of the data bits
+     * (everything except the last 24 bits) multiplied by x^24 modulo the
+     * generator. This is equivalent to xoring one entry of the classic
+     * per-bit parity table for every bit set in the message, but processes
+     * a whole byte per step using a 256 entry table built at compile time.
+     */
+    class CRC24
+    {
+    public:
+        static constexpr uint32_t Polynomial = 0xFFF409;
+        static constexpr uint32_t Mask = 0xFFFFFF;
+
+        /* Compute the CRC of the first 'len' bytes of 'data'. */
+        static constexpr uint32_t Checksum(const unsigned char *data, int len)
+        {
+            uint32_t crc = 0;
+            for (int i = 0; i < len; i++)
+                crc = ((crc << 8) ^ _table[((crc >> 16) ^ data[i]) & 0xFF]) & Mask;
+            return crc;
+        }
+
+        /* Compute the CRC of a Mode S message of 'bits' length (56 or 112),
+         * the trailing 24 parity bits are not part of the computation. */
+        static constexpr uint32_t MessageChecksum(const unsigned char *msg, int bits)
+        {
+            return Checksum(msg, (bits / 8) - 3);
+        }
+
+        /* Parity field as transmitted, the last 3 bytes of the message. */
+        static constexpr uint32_t MessageParity(const unsigned char *msg, int bits)
+        {
+            return ((uint32_t)msg[(bits / 8) - 3] << 16) |
+                   ((uint32_t)msg[(bits / 8) - 2] << 8) |
+                   (uint32_t)msg[(bits / 8) - 1];
+        }
+
+    private:
+        static constexpr auto _table = MakeCRC24Table<Polynomial>();
+    };
+
+    /* Syndrome lookup for correcting one or two bit errors.
+     *
+     * The syndrome of a message (computed CRC xor received parity) only
+     * depends on which bits were flipped, so every 1 and 2 bit error
+     * pattern of a 112 bit message is hashed once into an open addressed
+     * table. A 56 bit message is the tail of a 112 bit one with the same
+     * syndromes, so it shares the table and only accepts positions >= 56.
+     *
+     * Mode S CRC has a large enough distance that all of these syndromes
+     * are unique, the constructor fails to evaluate if that is not the case.
+     */
+    class CRC24Syndromes
+    {
+    public:
+        static constexpr int Bits = 112;
+        static constexpr int SizeBits = 14;
+        static constexpr int Size = 1 << SizeBits; /* ~40% load. */
+
+        constexpr CRC24Syndromes() : _entries()
+        {
+            uint32_t single[Bits] = {};
+            for (int j = 0; j < Bits; j++)
+                single[j] = bitSyndrome(j);
+
+            for (int j = 0; j < Bits; j++)
+            {
+                insert(single[j], j, NoBit);
+                for (int i = j + 1; i < Bits; i++)
+                    insert(single[j] ^ single[i], j, i);
+            }
+        }
+
+        /* Returns the bit position(s) that explain 'syndrome' in a message of
+         * 'bits' length, encoded as 'j' or 'j | (i << 8)' for two bits, or -1
+         * if no pattern of at most 'maxErrors' flipped bits matches. */
+        constexpr int Lookup(uint32_t syndrome, int bits, int maxErrors) const
+        {
+            int offset = Bits - bits;
+
+            for (uint32_t h = hash(syndrome);; h = (h + 1) & (Size - 1))
+            {
+                const Entry &e = _entries[h];
+                if (e.syndrome == 0)
+                    return -1;
+                if (e.syndrome != syndrome)
+                    continue;
+
+                if (e.first < offset || (e.second != NoBit && maxErrors < 2))
+                    return -1;
+                if (e.second == NoBit)
+                    return e.first - offset;
+                return (e.first - offset) | ((e.second - offset) << 8);
+            }
+        }
+
+    private:
+        static constexpr uint8_t NoBit = 0xFF;
+
+        struct Entry
+        {
+            uint32_t syndrome = 0;
+            uint8_t first = 0;
+            uint8_t second = 0;
+        };
+
+        Entry _entries[Size];
+
+        static constexpr uint32_t hash(uint32_t syndrome)
+        {
+            return (syndrome * 0x9E3779B1u) >> (32 - SizeBits);
+        }
+
+        /* Syndrome produced by flipping bit 'j' of a 112 bit message. */
+        static constexpr uint32_t bitSyndrome(int j)
+        {
+            if (j >= Bits - 24)
+                return 1u << (Bits - 1 - j);
+
+            unsigned char msg[Bits / 8] = {};
+            msg[j / 8] = 1 << (7 - (j % 8));
+            return CRC24::MessageChecksum(msg, Bits);
+        }
+
+        constexpr void insert(uint32_t syndrome, int first, int second)
+        {
+            uint32_t h = hash(syndrome);
+            while (_entries[h].syndrome != 0)
+            {
+                if (_entries[h].syndrome == syndrome)
+                    throw "Ambiguous CRC24 syndrome";
+                h = (h + 1) & (Size - 1);
+            }
+            _entries[h] = {syndrome, (uint8_t)first, (uint8_t)second};
+        }
+    };
+
+} // namespace ssr::ads_b::transport
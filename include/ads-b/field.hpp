@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stdint.h>
+#include <memory.h>
+
+namespace ssr::ads_b::es
+{
+    /* A 56 bit ME/MB field, held in the low bits of a uint64_t in on-wire
+     * order: ME bit 1 (the first bit transmitted) is bit 55. */
+    typedef uint64_t me_type;
+
+    /* Load the ME field (bytes 4-10) of a long Mode S message with a
+     * single unaligned load and a byte swap. Reads 8 bytes, the message
+     * buffer must be a full MODES_LONG_MSG_BYTES. */
+    static inline me_type LoadME(const unsigned char *msg)
+    {
+        uint64_t v;
+        memcpy(&v, msg + 4, sizeof(v));
+        return __builtin_bswap64(v) >> 8;
+    }
+
+    /* Field of 'Bits' bits starting at ME bit 'Start', numbered from 1 like
+     * the register tables of Doc 9871 / DO-260B. Get is a shift and a mask,
+     * independent of compiler bitfield layout and host byte order. */
+    template <int Start, int Bits, class T = uint32_t>
+    struct Field
+    {
+        static_assert(Start >= 1 && Bits >= 1 && Start + Bits - 1 <= 56, "Field outside the 56 bit ME field");
+
+        static constexpr int Shift = 56 - (Start - 1) - Bits;
+        static constexpr me_type Mask = (1ull << Bits) - 1;
+
+        static constexpr T Get(me_type me) { return (T)((me >> Shift) & Mask); }
+
+        static constexpr me_type Set(me_type me, T v)
+        {
+            return (me & ~(Mask << Shift)) | (((me_type)v & Mask) << Shift);
+        }
+    };
+    static_assert(Field<1, 5>::Get(0x58C901375147EFull) == 11);
+    static_assert(Field<40, 17>::Get(0x58C901375147EFull) == 0x147EF);
+    static_assert(Field<40, 17>::Set(0, 0x147EF) == 0x147EF);
+
+} // namespace ssr::ads_b::es
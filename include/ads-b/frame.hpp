@@ -0,0 +1,90 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <ads-b/crc.hpp>
+
+namespace ssr::ads_b::transport
+{
+    /* Non-owning view over a raw Mode S message.
+     *
+     * Nothing is decoded up front, every accessor extracts its field from
+     * the raw bits when called, so a consumer that only needs the DF, the
+     * address and the CRC result pays for exactly that. The view is only
+     * valid as long as the message bytes it points to.
+     */
+    class ModeSFrame
+    {
+    public:
+        constexpr ModeSFrame(const unsigned char *msg, int bytes) : _msg(msg), _len(bytes) {}
+
+        constexpr const unsigned char *Data() const { return _msg; }
+        constexpr int Bits() const { return _len * 8; }
+
+        /* Downlink format, DF24 and up only use the first two bits */
+        constexpr int DownlinkFormat() const
+        {
+            int df = _msg[0] >> 3;
+            return df >= 24 ? 24 : df;
+        }
+
+        /* CA (DF11/17), CF (DF18), AF (DF19) or FS (DF4/5/20/21) */
+        constexpr int Capability() const { return _msg[0] & 7; }
+
+        /* Address/parity field as transmitted (last 24 bits) */
+        constexpr uint32_t Parity() const { return CRC24::MessageParity(_msg, Bits()); }
+
+        /* CRC of the message bits before the parity field */
+        constexpr uint32_t Checksum() const { return CRC24::MessageChecksum(_msg, Bits()); }
+
+        /* Checksum xor parity, 0 for an intact DF11/17/18 message and the
+         * ICAO address for formats with address/parity (AP) */
+        constexpr uint32_t Syndrome() const { return Checksum() ^ Parity(); }
+
+        /* True for formats carrying the address in the clear (AA field),
+         * military DF19 only does with application field AF=0 */
+        constexpr bool HasAddressField() const
+        {
+            int df = DownlinkFormat();
+            return df == 11 || df == 17 || df == 18 || (df == 19 && Capability() == 0);
+        }
+
+        /* CRC result for AA formats, AP formats can only be checked against
+         * a list of known addresses, see ModeS::bruteForceAP */
+        constexpr bool CrcOk() const { return HasAddressField() && Syndrome() == 0; }
+
+        /* ICAO address: the AA field, or recovered from the AP field */
+        constexpr uint32_t IcaoAddress() const
+        {
+            if (HasAddressField())
+                return ((uint32_t)_msg[1] << 16) | ((uint32_t)_msg[2] << 8) | _msg[3];
+            return Syndrome();
+        }
+
+        /* 56 bit ME field of DF17/18 (MB field of DF20/21) */
+        constexpr uint64_t Data56() const
+        {
+            uint64_t v = 0;
+            for (int i = 4; i < 11; i++)
+                v = (v << 8) | _msg[i];
+            return v;
+        }
+
+        /* Extended squitter type code and subtype */
+        constexpr int TypeCode() const { return _msg[4] >> 3; }
+        constexpr int SubType() const { return _msg[4] & 7; }
+
+        /* Raw 13 bit AC (DF0/4/16/20) or ID (DF5/21) field */
+        constexpr int AC13() const { return ((_msg[2] & 0x1F) << 8) | _msg[3]; }
+        constexpr int ID13() const { return AC13(); }
+
+        /* Raw 12 bit altitude field of an airborne position */
+        constexpr int AC12() const { return (_msg[5] << 4) | (_msg[6] >> 4); }
+
+    private:
+        const unsigned char *_msg;
+        uint8_t _len;
+    };
+    static_assert(sizeof(ModeSFrame) == 16);
+
+} // namespace ssr::ads_b::transport
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <array>
+#include <memory.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace ssr::ads_b::transport
+{
+    /* Nibble value of every character, 0xFF for anything not 0-9, a-f or A-F */
+    static constexpr std::array<uint8_t, 256> MakeHexTable()
+    {
+        std::array<uint8_t, 256> t{};
+        for (int c = 0; c < 256; c++)
+        {
+            if (c >= '0' && c <= '9')
+                t[c] = c - '0';
+            else if (c >= 'a' && c <= 'f')
+                t[c] = c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F')
+                t[c] = c - 'A' + 10;
+            else
+                t[c] = 0xFF;
+        }
+        return t;
+    }
+
+    /* Hex payload to binary conversion for text inputs.
+     *
+     * A Mode S payload is at most 28 characters, so the whole payload is
+     * copied into a 32 byte block padded with '0' and converted at once:
+     * every character is classified as digit or letter with unsigned range
+     * compares, any character in neither range fails a single mask test,
+     * and pairs of nibbles are merged with a shift and packed to bytes.
+     * Uses AVX2 when the build enables it, SSE2 on any other x86-64 and
+     * a lookup table elsewhere.
+     */
+    class Hex
+    {
+    public:
+        static constexpr size_t MaxChars = 32;
+        static constexpr std::array<uint8_t, 256> Table = MakeHexTable();
+
+        /* Nibble value of 'c', or -1 if it is not a hex digit */
+        static constexpr int DigitVal(unsigned char c)
+        {
+            return Table[c] == 0xFF ? -1 : Table[c];
+        }
+
+        /* Convert 'chars' hex characters (even, at most MaxChars) into
+         * chars / 2 bytes of 'out'. Returns false if any of them is not a
+         * hex digit, 'out' is left undefined then. */
+        static bool Decode(const char *hex, size_t chars, unsigned char *out)
+        {
+            if ((chars & 1) || chars > MaxChars)
+                return false;
+
+#if defined(__AVX2__) || defined(__SSE2__)
+            alignas(32) char block[MaxChars];
+            alignas(16) unsigned char bytes[MaxChars / 2];
+
+            memset(block, '0', sizeof(block));
+            memcpy(block, hex, chars);
+            if (!decodeBlock(block, bytes))
+                return false;
+            memcpy(out, bytes, chars / 2);
+            return true;
+#else
+            for (size_t j = 0; j < chars; j += 2)
+            {
+                uint8_t high = Table[(unsigned char)hex[j]];
+                uint8_t low = Table[(unsigned char)hex[j + 1]];
+
+                if ((high | low) & 0xF0)
+                    return false;
+                out[j / 2] = (high << 4) | low;
+            }
+            return true;
+#endif
+        }
+
+    private:
+#if defined(__AVX2__)
+        static bool decodeBlock(const char *block, unsigned char *out)
+        {
+            __m256i v = _mm256_load_si256((const __m256i *)block);
+
+            /* v - '0' <= 9 for digits, (v | 0x20) - 'a' <= 5 for letters */
+            __m256i digit = _mm256_sub_epi8(v, _mm256_set1_epi8('0'));
+            __m256i alpha = _mm256_sub_epi8(_mm256_or_si256(v, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+            __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+            __m256i is_alpha = _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, _mm256_set1_epi8(5)), alpha);
+
+            if ((uint32_t)_mm256_movemask_epi8(_mm256_or_si256(is_digit, is_alpha)) != 0xFFFFFFFF)
+                return false;
+
+            __m256i nibble = _mm256_or_si256(_mm256_and_si256(is_digit, digit),
+                                             _mm256_and_si256(is_alpha, _mm256_add_epi8(alpha, _mm256_set1_epi8(10))));
+
+            /* The high nibble is the first character of each pair, the low
+             * byte of every 16 bit lane */
+            __m256i pairs = _mm256_or_si256(_mm256_slli_epi16(nibble, 4), _mm256_srli_epi16(nibble, 8));
+            pairs = _mm256_and_si256(pairs, _mm256_set1_epi16(0xFF));
+
+            /* Packing works per 128 bit lane, gather both halves */
+            __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(pairs, pairs), 0x08);
+            _mm_store_si128((__m128i *)out, _mm256_castsi256_si128(packed));
+            return true;
+        }
+#elif defined(__SSE2__)
+        static inline __m128i nibbles(__m128i v, __m128i &valid)
+        {
+            /* v - '0' <= 9 for digits, (v | 0x20) - 'a' <= 5 for letters */
+            __m128i digit = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+            __m128i alpha = _mm_sub_epi8(_mm_or_si128(v, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+            __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+            __m128i is_alpha = _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha);
+
+            valid = _mm_and_si128(valid, _mm_or_si128(is_digit, is_alpha));
+
+            __m128i nibble = _mm_or_si128(_mm_and_si128(is_digit, digit),
+                                          _mm_and_si128(is_alpha, _mm_add_epi8(alpha, _mm_set1_epi8(10))));
+
+            /* The high nibble is the first character of each pair, the low
+             * byte of every 16 bit lane */
+            __m128i pairs = _mm_or_si128(_mm_slli_epi16(nibble, 4), _mm_srli_epi16(nibble, 8));
+            return _mm_and_si128(pairs, _mm_set1_epi16(0xFF));
+        }
+
+        static bool decodeBlock(const char *block, unsigned char *out)
+        {
+            __m128i valid = _mm_set1_epi8(-1);
+            __m128i lo = nibbles(_mm_load_si128((const __m128i *)block), valid);
+            __m128i hi = nibbles(_mm_load_si128((const __m128i *)(block + 16)), valid);
+
+            if (_mm_movemask_epi8(valid) != 0xFFFF)
+                return false;
+
+            _mm_store_si128((__m128i *)out, _mm_packus_epi16(lo, hi));
+            return true;
+        }
+#endif
+    };
+
+} // namespace ssr::ads_b::transport
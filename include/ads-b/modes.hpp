@@ -11,11 +11,20 @@
 
 #include <stdint.h>
 #include <string>
+#include <string_view>
 #include <memory>
 #include <memory.h>
 #include <cmath>
 
+#include <util.hpp>
 #include <ads-b/system.hpp>
+#include <ads-b/crc.hpp>
+#include <ads-b/batch.hpp>
+#include <ads-b/frame.hpp>
+#include <ads-b/altitude.hpp>
+#include <ads-b/hex.hpp>
+#include <ads-b/velocity.hpp>
+#include <ads-b/whitelist.hpp>
 
 #define FIX_1_BIT_ERRORS true
 #define FIX_2_BIT_ERRORS true
@@ -24,8 +33,8 @@
 #define MODES_LONG_MSG_BITS 112
 #define MODES_LONG_MSG_BYTES (MODES_LONG_MSG_BITS / 8)
 
-#define MODES_ICAO_CACHE_LEN 1024 /* Power of two required. */
-#define MODES_ICAO_CACHE_TTL 60   /* Time to live of cached addresses. */
+#define MODES_ICAO_CACHE_LEN 65536 /* Addresses, rounded up to a power of two. */
+#define MODES_ICAO_CACHE_TTL 60    /* Time to live of cached addresses, seconds. */
 #define MODES_UNIT_FEET 0
 #define MODES_UNIT_METERS 1
 
@@ -46,14 +55,23 @@ namespace ssr::ads_b::transport
         CommD_ELM = 24               /* Comm-D ELM */
     };
 
-    struct __attribute__((__packed__)) ModeSNew {
-        uint32_t parity : 24;
-        uint64_t data : 56;
-        uint32_t icao_address : 24;
-        uint8_t capability : 3;
-        uint8_t downlink_format : 5;
-    };
-    static_assert(sizeof(ModeSNew) == 14);
+    /* Try to fix up to 'maxErrors' (1 or 2) flipped bits given the message
+    * syndrome (computed CRC xor received parity) with a single lookup in
+    * the precomputed syndrome table. On success modifies the buffer and
+    * returns the error bit position(s) as 'j' or 'j | (i << 8)',
+    * otherwise -1 is returned. */
+    int FixBitErrors(unsigned char *msg, int bits, uint32_t syndrome, int maxErrors);
+
+    /* Try to fix single bit errors using the checksum. On success modifies
+    * the original buffer with the fixed version, and returns the position
+    * of the error bit. Otherwise if fixing failed -1 is returned. */
+    int FixSingleBitErrors(unsigned char *msg, int bits);
+
+    /* Similar to FixSingleBitErrors() but also tries every possible two bit
+    * combination, returned as 'j | (i << 8)'. Two bit correction has a
+    * higher chance of accepting garbage, so it should only be tried against
+    * DF17 messages that don't pass the checksum. */
+    int FixTwoBitsErrors(unsigned char *msg, int bits);
 
     /* The struct we use to store information about a decoded message. */
     struct modesMessage
@@ -83,13 +101,14 @@ namespace ssr::ads_b::transport
         int raw_longitude;    /* Non decoded longitude */
         char flight[9];       /* 8 chars flight number. */
         int ew_dir;           /* 0 = East, 1 = West. */
-        int ew_velocity;      /* E/W velocity. */
+        int ew_velocity;      /* E/W velocity in kt. */
         int ns_dir;           /* 0 = North, 1 = South. */
-        int ns_velocity;      /* N/S velocity. */
+        int ns_velocity;      /* N/S velocity in kt. */
         int vert_rate_source; /* Vertical rate source. */
         int vert_rate_sign;   /* Vertical rate sign. */
         int vert_rate;        /* Vertical rate. */
         int velocity;         /* Computed from EW and NS velocity. */
+        int velocity_is_valid; /* False when the message carries no speed. */
 
         /* DF4, DF5, DF20, DF21 */
         int fs;       /* Flight status for DF4,5,20,21 */
@@ -99,68 +118,46 @@ namespace ssr::ads_b::transport
 
         /* Fields used by multiple message types. */
         int altitude, unit;
+
+        /* Receiver metadata, when the input format carries it. */
+        uint64_t timestamp; /* 48 bit MLAT timestamp, 0 if unknown. */
+        int signal;         /* Signal level, 0 if unknown. */
     };
 
+    /* Per format decoders, see modes.cpp */
+    template <int DF>
+    struct Decoder;
+    template <int TC>
+    struct EsDecoder;
+    struct APDecoder;
+    struct AADecoder;
+
     class ModeS
     {
+        template <int>
+        friend struct Decoder;
+        template <int>
+        friend struct EsDecoder;
+        friend struct APDecoder;
+        friend struct AADecoder;
+
     private:
-        uint32_t icao_cache[MODES_ICAO_CACHE_LEN * 2];
+        ICAOWhitelist icao_cache{MODES_ICAO_CACHE_LEN, MODES_ICAO_CACHE_TTL * 1000};
+        uint64_t _now = 0; /* Loop time in ms, see setTime() */
         ssr::ads_b::System _sys;
         
-        /* Parity table for MODE S Messages.
-        * The table contains 112 elements, every element corresponds to a bit set
-        * in the message, starting from the first bit of actual data after the
-        * preamble.
-        *
-        * For messages of 112 bit, the whole table is used.
-        * For messages of 56 bits only the last 56 elements are used.
-        *
-        * The algorithm is as simple as xoring all the elements in this table
-        * for which the corresponding bit on the message is set to 1.
-        *
-        * The latest 24 elements in this table are set to 0 as the checksum at the
-        * end of the message should not affect the computation.
+        /* Compute the parity of a MODE S message of 'bits' length, see CRC24.
         *
         * Note: this function can be used with DF11 and DF17, other modes have
         * the CRC xored with the sender address as they are reply to interrogations,
         * but a casual listener can't split the address from the checksum.
         */
-        uint32_t modes_checksum_table[112] = {
-            0x3935ea, 0x1c9af5, 0xf1b77e, 0x78dbbf, 0xc397db, 0x9e31e9, 0xb0e2f0, 0x587178,
-            0x2c38bc, 0x161c5e, 0x0b0e2f, 0xfa7d13, 0x82c48d, 0xbe9842, 0x5f4c21, 0xd05c14,
-            0x682e0a, 0x341705, 0xe5f186, 0x72f8c3, 0xc68665, 0x9cb936, 0x4e5c9b, 0xd8d449,
-            0x939020, 0x49c810, 0x24e408, 0x127204, 0x093902, 0x049c81, 0xfdb444, 0x7eda22,
-            0x3f6d11, 0xe04c8c, 0x702646, 0x381323, 0xe3f395, 0x8e03ce, 0x4701e7, 0xdc7af7,
-            0x91c77f, 0xb719bb, 0xa476d9, 0xadc168, 0x56e0b4, 0x2b705a, 0x15b82d, 0xf52612,
-            0x7a9309, 0xc2b380, 0x6159c0, 0x30ace0, 0x185670, 0x0c2b38, 0x06159c, 0x030ace,
-            0x018567, 0xff38b7, 0x80665f, 0xbfc92b, 0xa01e91, 0xaff54c, 0x57faa6, 0x2bfd53,
-            0xea04ad, 0x8af852, 0x457c29, 0xdd4410, 0x6ea208, 0x375104, 0x1ba882, 0x0dd441,
-            0xf91024, 0x7c8812, 0x3e4409, 0xe0d800, 0x706c00, 0x383600, 0x1c1b00, 0x0e0d80,
-            0x0706c0, 0x038360, 0x01c1b0, 0x00e0d8, 0x00706c, 0x003836, 0x001c1b, 0xfff409,
-            0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
-            0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
-            0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000};
-
         uint32_t modesChecksum(unsigned char *msg, int bits);
 
         /* Given the Downlink Format (DF) of the message, return the message length
         * in bits. */
         int modesMessageLenByType(int type);
 
-        /* Try to fix single bit errors using the checksum. On success modifies
-        * the original buffer with the fixed version, and returns the position
-        * of the error bit. Otherwise if fixing failed -1 is returned. */
-        int fixSingleBitErrors(unsigned char *msg, int bits);
-
-        /* Similar to fixSingleBitErrors() but try every possible two bit combination.
-        * This is very slow and should be tried only against DF17 messages that
-        * don't pass the checksum, and only in Aggressive Mode. */
-        int fixTwoBitsErrors(unsigned char *msg, int bits);
-
-        /* Hash the ICAO address to index our cache of MODES_ICAO_CACHE_LEN
-        * elements, that is assumed to be a power of two. */
-        uint32_t ICAOCacheHashAddress(uint32_t a);
-
         /* Add the specified entry to the cache of recently seen ICAO addresses.
         * Note that we also add a timestamp so that we can make sure that the
         * entry is only valid for MODES_ICAO_CACHE_TTL seconds. */
@@ -199,46 +196,113 @@ namespace ssr::ads_b::transport
 
         /* Decode a raw Mode S message demodulated as a stream of bytes by
         * detectModeS(), and split it into fields populating a modesMessage
-        * structure. */
-        void decodeModesMessage(struct modesMessage *mm, unsigned char *msg);
-
-        /* Turn an hex digit into its 4 bit decimal value.
-        * Returns -1 if the digit is not in the 0-F range. */
-        int hexDigitVal(int c);
+        * structure. If 'frame' was already checked by the mixer, 'msg' is its
+        * corrected copy and its CRC result is used as is. */
+        void decodeModesMessage(struct modesMessage *mm, unsigned char *msg, const RawFrame *frame = nullptr);
 
     public:
         /* This function decodes a string representing a Mode S message in
         * raw hex format like: *8D4B969699155600E87406F5B69F;
-        * The string is supposed to be at the start of the client buffer
-        * and null-terminated.
+        * The line is passed without its line terminator and does not need to
+        * be null-terminated. The message is decoded into 'mm', owned by the
+        * caller so nothing is allocated. Returns false if the line is not a
+        * valid hex message.
         */
-        std::unique_ptr<struct modesMessage> decodeHexMessage(const std::string &line)
+        bool decodeHexMessage(std::string_view line, struct modesMessage &mm)
+        {
+            RawFrame frame;
+
+            if (!decodeHexFrame(line, frame) || !decodeBinaryMessage(frame.data, frame.len, mm))
+                return false;
+
+            mm.timestamp = frame.timestamp;
+            mm.signal = frame.signal;
+            return true;
+        }
+
+        /* Turn a raw hex line into binary. Accepts the AVR variants:
+        *
+        *   *8D4B969699155600E87406F5B69F;                 plain
+        *   @0A1B2C3D4E5F8D4B969699155600E87406F5B69F;     48 bit MLAT timestamp
+        *   %0A1B2C3D4E5FA48D4B969699155600E87406F5B69F;   timestamp and signal level
+        *
+        * The timestamp and signal level are 12 and 2 hex digits in front of
+        * the payload. Returns false if the line is not a valid hex Mode S
+        * message. Uses no decoder state. */
+        static bool decodeHexFrame(std::string_view line, RawFrame &frame)
         {
             const char *hex = line.data();
-            int l = line.length(), j;
-            unsigned char msg[MODES_LONG_MSG_BYTES];
-            struct modesMessage mm;
+            int l = line.length();
+            int header;
+
+            switch (l > 0 ? hex[0] : 0)
+            {
+            case '*':
+                header = 0;
+                break;
+            case '@':
+                header = 12;
+                break;
+            case '%':
+                header = 14;
+                break;
+            default:
+                return false;
+            }
 
             /* Turn the message into binary. */
-            if (l < 2 || hex[0] != '*' || hex[l - 1] != ';')
-                return 0;
+            if (l < 2 + header || hex[l - 1] != ';')
+                return false;
             hex++;
-            l -= 2; /* Skip * and ; */
-            if (l > MODES_LONG_MSG_BYTES * 2)
-                return 0; /* Too long message... broken. */
-            for (j = 0; j < l; j += 2)
-            {
-                int high = hexDigitVal(hex[j]);
-                int low = hexDigitVal(hex[j + 1]);
+            l -= 2 + header; /* Skip prefix, header and ; */
+            if (l != MODES_SHORT_MSG_BITS / 4 && l != MODES_LONG_MSG_BITS / 4)
+                return false; /* Mode A/C reply or broken */
 
-                if (high == -1 || low == -1)
-                    return 0;
-                msg[j / 2] = (high << 4) | low;
+            frame.signal = 0;
+            frame.timestamp = 0;
+            frame.time = 0;
+            frame.source = 0;
+            if (header != 0)
+            {
+                unsigned char meta[7];
+                if (!Hex::Decode(hex, header, meta))
+                    return false;
+                frame.timestamp = ssr::__u48((const char *)meta);
+                if (header == 14)
+                    frame.signal = meta[6];
+                hex += header;
             }
 
-            decodeModesMessage(&mm, msg);
+            if (!Hex::Decode(hex, l, frame.data))
+                return false;
+            frame.len = l / 2;
+            return true;
+        }
+
+        /* Decode a Mode S message of 'len' (7 or 14) raw bytes, as received
+        * from binary inputs, into 'mm'. Missing bytes of a short frame are
+        * zero. Returns false if 'len' is out of range. */
+        bool decodeBinaryMessage(const unsigned char *data, int len, struct modesMessage &mm)
+        {
+            unsigned char msg[MODES_LONG_MSG_BYTES] = {};
 
-            return std::make_unique<struct modesMessage>(mm);
+            if (len <= 0 || len > MODES_LONG_MSG_BYTES)
+                return false;
+            memcpy(msg, data, len);
+
+            mm = {};
+            decodeModesMessage(&mm, msg);
+            return true;
         }
+
+        /* Set the time used for the ICAO address cache, in ms of a monotonic
+        * clock such as the loop time. Call it once per batch, messages are
+        * stamped with it instead of reading the clock for each one. */
+        void setTime(uint64_t nowMs) { _now = nowMs; }
+
+        /* Decode 'count' frames into the columns of 'out', appending after
+        * the rows already in it. Stops when the batch is full and returns
+        * the number of frames consumed. Does not allocate. */
+        size_t decodeBatch(const RawFrame *frames, size_t count, MessageBatch &out);
     };
 } // namespace ssr::decoder
\ No newline at end of file
@@ -1,35 +1,91 @@
 #pragma once
 
 #include <stdint.h>
-#include <exception>
+#include <stddef.h>
 #include <int56.hpp>
 
-/* Change me */
-typedef /* ssr::uint56_t */ uint64_t register_type;
+/* Content of one transponder register, a 56 bit ME/MB field */
+typedef ssr::uint56_t register_type;
 
 namespace ssr::ads_b {
     /* ADS-B Transponder Registers
      *
      * As Assigned in A.2.1 of Doc.9871
      *
+     * Only a handful of the 255 registers are ever seen for an aircraft,
+     * so they are stored sparsely: a bitmap of the registers present and
+     * a packed inline array of up to Capacity values ordered by register
+     * number. The index of a register in the array is the number of
+     * present registers below it. Nothing is allocated. Capacity covers
+     * every register an aircraft broadcasts or answers unsolicited, with
+     * room to spare, and keeps an Aircraft within three cache lines.
      */
     class Registers {
+    public:
+        static constexpr size_t Capacity = 12;
+
     private:
-        register_type storage[0xFF];
+        uint64_t _present[4] = {};
+        register_type _values[Capacity] = {};
+        uint8_t _count = 0;
+
+        constexpr bool has(uint8_t reg) const {
+            return _present[reg >> 6] & (1ull << (reg & 63));
+        }
+
+        size_t rank(uint8_t reg) const {
+            size_t n = 0;
+            for (int w = 0; w < (reg >> 6); w++)
+                n += __builtin_popcountll(_present[w]);
+            return n + __builtin_popcountll(_present[reg >> 6] & ((1ull << (reg & 63)) - 1));
+        }
 
     public:
-        constexpr auto Value(uint8_t reg)                  -> register_type&         { return storage[reg]; }
-        constexpr auto Value(uint8_t reg)            const -> const register_type&   { return storage[reg]; }
+        constexpr bool Has(uint8_t reg) const { return has(reg); }
 
+        /* Number of registers present */
+        size_t Count() const { return _count; }
+
+        /* Returns 0 when the register was never set */
+        auto Value(uint8_t reg) const -> register_type {
+            return has(reg) ? _values[rank(reg)] : register_type();
+        }
+
+        /* Returns false when the register is new and Capacity are taken */
+        bool Set(uint8_t reg, register_type value) {
+            size_t i = rank(reg);
+            if (has(reg)) {
+                _values[i] = value;
+                return true;
+            }
+            if (_count == Capacity)
+                return false;
+            for (size_t j = _count; j > i; j--)
+                _values[j] = _values[j - 1];
+            _values[i] = value;
+            _count++;
+            _present[reg >> 6] |= 1ull << (reg & 63);
+            return true;
+        }
+
+        void Clear(uint8_t reg) {
+            if (!has(reg))
+                return;
+            _count--;
+            for (size_t j = rank(reg); j < _count; j++)
+                _values[j] = _values[j + 1];
+            _present[reg >> 6] &= ~(1ull << (reg & 63));
+        }
+
+        /* TMsg is one of the es:: register views, which wrap the 56 bit
+         * value and decode their fields from it on access. */
         template<class TMsg>
-        constexpr auto SetData(uint8_t reg, const TMsg& m) {
-            static_assert(sizeof(TMsg) == 7);
-            storage[reg] = (uint64_t)m;
+        bool SetData(uint8_t reg, const TMsg& m) {
+            return Set(reg, register_type(m.me));
         }
         template<class TMsg>
-        constexpr auto GetData(uint8_t reg) const -> const TMsg& {
-            static_assert(sizeof(TMsg) == 7);
-            return (const TMsg)storage[reg];
+        auto GetData(uint8_t reg) const -> TMsg {
+            return TMsg{Value(reg).Value()};
         }
         
         /* 0x00: Not valid */
@@ -152,7 +208,8 @@ namespace ssr::ads_b {
         /* Extended Squitter: Emergency/Priority Status */
         static constexpr auto ES_EmergencyStatus = 0x61;
         
-        /* 0x62: Reserved for target state and status information */
+        /* Extended Squitter: Target State and Status */
+        static constexpr auto ES_TargetState = 0x62;
         /* 0x63: Reserved for extended squitter */
         /* 0x64: Reserved for extended squitter */
         
@@ -192,9 +249,31 @@ namespace ssr::ads_b {
         
         /* 0xF3-0xFF: Reserved */
 
+        /* Register an extended squitter of type code 'tc' is broadcast from,
+         * 0 when the type code has no register. */
+        static constexpr uint8_t ForTypeCode(int tc) {
+            if (tc >= 1 && tc <= 4)
+                return ES_IdentAndCategory;
+            if (tc >= 5 && tc <= 8)
+                return ES_SurfacePosition;
+            if ((tc >= 9 && tc <= 18) || (tc >= 20 && tc <= 22))
+                return ES_AirbornePosition;
+            if (tc == 19)
+                return ES_AirborneVelocity;
+            if (tc == 28)
+                return ES_EmergencyStatus;
+            if (tc == 29)
+                return ES_TargetState;
+            if (tc == 31)
+                return ES_OperationalStatus;
+            return 0;
+        }
+
         /* Creates a Comm-B Data Selector */
-        static constexpr const uint8_t BDS(uint8_t bds_1, uint8_t bds_2) {
-            return (bds_1 << 4) || (bds_2 && 0x0F);
+        static constexpr uint8_t BDS(uint8_t bds_1, uint8_t bds_2) {
+            return (uint8_t)((bds_1 << 4) | (bds_2 & 0x0F));
         }
     };
-}
\ No newline at end of file
+    static_assert(Registers::BDS(0, 5) == Registers::ES_AirbornePosition);
+    static_assert(Registers::BDS(1, 7) == Registers::GICBCapability);
+}
@@ -11,12 +11,7 @@ namespace ssr::ads_b
 
     public:
         auto ES_AirbornePosition() const -> es::AirbornePosition {
-            es::AirbornePosition ret;
-            auto reg = Registers::BDS(0, 5);
-
-            auto data = _reg.Value(Registers::ES_AirbornePosition);
-
-            return ret;
+            return _reg.GetData<es::AirbornePosition>(Registers::ES_AirbornePosition);
         }
     };
 } // namespace ssr::ads_b
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace ssr::ads_b::transport
+{
+    /* Speed and direction of a velocity vector given by its north and east
+     * components, in the units of the components and whole degrees
+     * clockwise from north (0-359). */
+    struct GroundVector
+    {
+        int speed;
+        int track;
+    };
+
+    /* Fixed point polar conversion of velocity components with CORDIC.
+     *
+     * The vector is rotated towards the north axis in Iterations steps of
+     * atan(2^-i), using only shifts and adds. The angle is accumulated as
+     * a binary angle (2^32 = 360 degrees), so it wraps into 0-360 on its
+     * own, and the length left on the axis is the speed times the CORDIC
+     * gain, which is divided out with one multiply.
+     *
+     * For components of up to 16383 (4088 kt for supersonic subtypes) the
+     * residual angle is below 0.002 degrees and the length error below
+     * 0.01 units before rounding, so speed and track are the exact values
+     * rounded to the nearest knot and degree, within 0.51 of either.
+     */
+    class Cordic
+    {
+    public:
+        static constexpr int Iterations = 16;
+        static constexpr int MaxComponent = (1 << 14) - 1;
+
+        static constexpr GroundVector Polar(int north, int east)
+        {
+            if (north == 0 && east == 0)
+                return {0, 0};
+
+            /* 15 fractional bits */
+            int64_t x = (int64_t)north * (1 << Scale);
+            int64_t y = (int64_t)east * (1 << Scale);
+            uint32_t angle = 0;
+
+            /* Start in the right half plane */
+            if (x < 0)
+            {
+                x = -x;
+                y = -y;
+                angle = 0x80000000u;
+            }
+
+            for (int i = 0; i < Iterations; i++)
+            {
+                int64_t dx = y >> i, dy = x >> i;
+                if (y > 0)
+                {
+                    x += dx;
+                    y -= dy;
+                    angle += Atan[i];
+                }
+                else
+                {
+                    x -= dx;
+                    y += dy;
+                    angle -= Atan[i];
+                }
+            }
+
+            GroundVector v{};
+            v.speed = (int)(((uint64_t)x * InverseGain + (1ull << (31 + Scale))) >> (32 + Scale));
+            v.track = (int)(((uint64_t)angle * 360 + (1ull << 31)) >> 32);
+            if (v.track == 360)
+                v.track = 0;
+            return v;
+        }
+
+    private:
+        static constexpr int Scale = 15;
+
+        /* atan(2^-i) as binary angle */
+        static constexpr uint32_t Atan[Iterations] = {
+            536870912, 316933406, 167458907, 85004756, 42667331, 21354465, 10679838, 5340245,
+            2670163, 1335087, 667544, 333772, 166886, 83443, 41722, 20861};
+
+        /* 2^32 / prod(sqrt(1 + 2^-2i)) */
+        static constexpr uint64_t InverseGain = 2608131497u;
+    };
+
+    static_assert(Cordic::Polar(100, 0).speed == 100 && Cordic::Polar(100, 0).track == 0);
+    static_assert(Cordic::Polar(0, 100).track == 90 && Cordic::Polar(-100, 0).track == 180);
+    static_assert(Cordic::Polar(0, -100).track == 270 && Cordic::Polar(300, 400).speed == 500);
+
+} // namespace ssr::ads_b::transport
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <stdint.h>
+#include <memory>
+
+namespace ssr::ads_b::transport
+{
+    /* Set of ICAO addresses recently seen with a clean CRC.
+     *
+     * Set associative: an address hashes to one bucket of 'Ways' slots
+     * that fills exactly one cache line, so a lookup is a single line
+     * fetch. A colliding address only evicts another one when all slots
+     * of the bucket are live, and then the least recently seen one, so the
+     * table can be loaded well past the number of aircraft in range before
+     * live addresses start to drop out.
+     *
+     * Time is passed in by the caller (loop time in ms), nothing here
+     * reads the system clock.
+     */
+    class ICAOWhitelist
+    {
+    public:
+        static constexpr int Ways = 8;
+
+        /* 'capacity' is rounded up to a power of two number of slots */
+        ICAOWhitelist(uint32_t capacity, uint32_t ttlMs) : _ttl(ttlMs)
+        {
+            _buckets = 1;
+            while (_buckets * Ways < capacity)
+                _buckets <<= 1;
+            _table = std::make_unique<Bucket[]>(_buckets);
+        }
+
+        /* Remember 'addr' as seen at 'nowMs' */
+        void Add(uint32_t addr, uint64_t nowMs)
+        {
+            Bucket &b = _table[hash(addr) & (_buckets - 1)];
+            uint32_t now = (uint32_t)nowMs;
+            int victim = 0;
+
+            for (int i = 0; i < Ways; i++)
+            {
+                if (b.addr[i] == addr)
+                {
+                    b.seen[i] = now;
+                    return;
+                }
+                /* Empty slots first, then the least recently seen */
+                if (b.addr[victim] != 0 && (b.addr[i] == 0 || now - b.seen[i] > now - b.seen[victim]))
+                    victim = i;
+            }
+            b.addr[victim] = addr;
+            b.seen[victim] = now;
+        }
+
+        /* True if 'addr' was added no more than the TTL before 'nowMs' */
+        bool Contains(uint32_t addr, uint64_t nowMs) const
+        {
+            const Bucket &b = _table[hash(addr) & (_buckets - 1)];
+            uint32_t now = (uint32_t)nowMs;
+
+            for (int i = 0; i < Ways; i++)
+            {
+                if (b.addr[i] == addr)
+                    return addr != 0 && now - b.seen[i] <= _ttl;
+            }
+            return false;
+        }
+
+        uint32_t Capacity() const { return _buckets * Ways; }
+
+    private:
+        struct alignas(64) Bucket
+        {
+            uint32_t addr[Ways] = {}; /* 0 = empty */
+            uint32_t seen[Ways] = {}; /* Loop time in ms, wraps */
+        };
+        static_assert(sizeof(Bucket) == 64);
+
+        /* Every bit of the address affects every output bit with ~50%
+         * probability. */
+        static uint32_t hash(uint32_t a)
+        {
+            a = ((a >> 16) ^ a) * 0x45d9f3b;
+            a = ((a >> 16) ^ a) * 0x45d9f3b;
+            return (a >> 16) ^ a;
+        }
+
+        uint32_t _ttl;
+        uint32_t _buckets;
+        std::unique_ptr<Bucket[]> _table;
+    };
+
+} // namespace ssr::ads_b::transport
@@ -4,11 +4,52 @@
 
 namespace ssr
 {
-    class uint56_t
+    /* Unsigned 56 bit integer stored in 7 bytes, the size of a Mode S
+     * ME/MB field. It has no alignment requirement, so arrays of it are
+     * packed without padding. Arithmetic is done on a uint64_t: load the
+     * value with Value() (or a cast), work on it and store the result back.
+     * Every store truncates to 56 bits.
+     */
+    class __attribute__((__packed__)) uint56_t
     {
+    public:
+        static constexpr uint64_t Mask = (1ull << 56) - 1;
+
+        constexpr uint56_t() : low(0), mid(0), high(0) {}
+        constexpr uint56_t(uint64_t v) : low((uint32_t)v), mid((uint16_t)(v >> 32)), high((uint8_t)(v >> 48)) {}
+
+        constexpr uint64_t Value() const
+        {
+            return (uint64_t)low | ((uint64_t)mid << 32) | ((uint64_t)high << 48);
+        }
+        constexpr explicit operator uint64_t() const { return Value(); }
+
+        constexpr uint56_t &operator=(uint64_t v) { return *this = uint56_t(v); }
+
+        constexpr bool operator==(const uint56_t &o) const { return low == o.low && mid == o.mid && high == o.high; }
+        constexpr bool operator!=(const uint56_t &o) const { return !(*this == o); }
+        constexpr bool operator<(const uint56_t &o) const { return Value() < o.Value(); }
+        constexpr bool operator>(const uint56_t &o) const { return o < *this; }
+        constexpr bool operator<=(const uint56_t &o) const { return !(o < *this); }
+        constexpr bool operator>=(const uint56_t &o) const { return !(*this < o); }
+
+        constexpr uint56_t operator<<(int n) const { return uint56_t(Value() << n); }
+        constexpr uint56_t operator>>(int n) const { return uint56_t(Value() >> n); }
+        constexpr uint56_t operator&(const uint56_t &o) const { return uint56_t(Value() & o.Value()); }
+        constexpr uint56_t operator|(const uint56_t &o) const { return uint56_t(Value() | o.Value()); }
+        constexpr uint56_t operator^(const uint56_t &o) const { return uint56_t(Value() ^ o.Value()); }
+        constexpr uint56_t operator~() const { return uint56_t(~Value()); }
+
+        constexpr explicit operator bool() const { return (low | mid | high) != 0; }
+
     private:
         uint32_t low;
         uint16_t mid;
-        uint16_t high;
+        uint8_t high;
     };
-} // namespace ssr
\ No newline at end of file
+    static_assert(sizeof(uint56_t) == 7);
+    static_assert(alignof(uint56_t) == 1);
+    static_assert(uint56_t(0x0123456789ABCDEFull).Value() == 0x23456789ABCDEFull);
+    static_assert((uint56_t(0x80000000000000ull) << 1).Value() == 0);
+    static_assert((uint56_t(0x58C901375147EFull) >> 51).Value() == 11);
+} // namespace ssr
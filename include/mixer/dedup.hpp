@@ -0,0 +1,82 @@
+#pragma once
+
+#include <stdint.h>
+#include <memory>
+
+#include <mixer/framekey.hpp>
+
+namespace ssr::mixer
+{
+    /* Time windowed set of recently seen raw Mode S frames.
+     *
+     * The table is split into buckets of 'Ways' entries, a frame hashes to
+     * one bucket and is compared against the entries in it. Time is counted
+     * in generations of a quarter window, an entry older than the window is
+     * free to be reused, so nothing ever needs to be deleted. When a bucket
+     * holds only live entries the oldest is replaced, which at worst lets a
+     * duplicate through.
+     *
+     * All memory is allocated up front, Seen() does not allocate.
+     */
+    class Dedup
+    {
+    public:
+        static constexpr int Ways = 4;
+        static constexpr int Generations = 4; /* Per window */
+
+        /* 'capacity' is rounded up to a power of two number of entries */
+        Dedup(uint32_t capacity, uint32_t windowMs) : _genMs(windowMs / Generations ? windowMs / Generations : 1)
+        {
+            _buckets = 1;
+            while (_buckets * Ways < capacity)
+                _buckets <<= 1;
+            _entries = std::make_unique<Entry[]>(_buckets * Ways);
+        }
+
+        /* Returns true if the same frame was seen within the window,
+         * otherwise remembers it and returns false. */
+        bool Seen(const unsigned char *msg, int len, uint64_t nowMs)
+        {
+            uint32_t gen = (uint32_t)(nowMs / _genMs) + 1; /* 0 is never used */
+            FrameKey key(msg, len);
+
+            Entry *bucket = &_entries[(key.Hash() & (_buckets - 1)) * Ways];
+            Entry *victim = bucket;
+
+            for (int i = 0; i < Ways; i++)
+            {
+                Entry &e = bucket[i];
+                bool live = e.gen != 0 && gen - e.gen < Generations;
+
+                if (live && e.key == key)
+                {
+                    _duplicates++;
+                    return true;
+                }
+                if (!live)
+                    victim = &e;
+                else if (victim->gen != 0 && gen - victim->gen < Generations && e.gen < victim->gen)
+                    victim = &e;
+            }
+
+            victim->key = key;
+            victim->gen = gen;
+            return false;
+        }
+
+        uint64_t Duplicates() const { return _duplicates; }
+
+    private:
+        struct Entry
+        {
+            FrameKey key;
+            uint32_t gen = 0; /* Generation last seen, 0 = empty */
+        };
+
+        uint32_t _genMs;
+        uint32_t _buckets;
+        std::unique_ptr<Entry[]> _entries;
+        uint64_t _duplicates = 0;
+    };
+
+} // namespace ssr::mixer
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <stdint.h>
+#include <memory.h>
+
+namespace ssr::mixer
+{
+    /* A raw Mode S frame of up to 14 bytes packed into two words, so
+     * tables of frames compare and hash it without touching the bytes
+     * again. The length goes into the last byte of the second word,
+     * which a frame never fills. */
+    struct FrameKey
+    {
+        uint64_t a = 0, b = 0; /* Frame, zero padded, and its length */
+
+        FrameKey() = default;
+        FrameKey(const unsigned char *msg, int len)
+        {
+            memcpy(&a, msg, len < 8 ? len : 8);
+            if (len > 8)
+                memcpy(&b, msg + 8, len - 8);
+            ((unsigned char *)&b)[7] = (unsigned char)len;
+        }
+
+        bool operator==(const FrameKey &o) const { return a == o.a && b == o.b; }
+
+        uint64_t Hash() const
+        {
+            uint64_t h = a * 0x9E3779B97F4A7C15ull ^ b * 0xC2B2AE3D27D4EB4Full;
+            h ^= h >> 29;
+            h *= 0xBF58476D1CE4E5B9ull;
+            return h ^ (h >> 32);
+        }
+    };
+
+    static_assert(sizeof(FrameKey) == 16);
+
+} // namespace ssr::mixer
@@ -0,0 +1,273 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <ads-b/batch.hpp>
+
+namespace ssr::mixer
+{
+    /* Maps the MLAT timestamps of one feeder onto the local clock.
+     *
+     * Receivers count a free running 12 MHz clock, so their timestamps only
+     * order frames of the same receiver. The offset to the local clock is
+     * the smallest difference between arrival and receive time seen, the
+     * copy that was least delayed by the network. It creeps up slowly so it
+     * follows a receiver clock running slow, and is reset when the
+     * timestamps jump (receiver restart or counter wrap). The result is
+     * never later than the arrival time. Frames without a timestamp use
+     * their arrival time.
+     */
+    class ClockSync
+    {
+    public:
+        static constexpr uint64_t TicksPerUs = 12;
+        static constexpr int64_t ResyncUs = 1000 * 1000;
+        static constexpr int64_t CreepUs = 1; /* Per frame */
+
+        /* 'timestamp' in MLAT ticks, 'arrivalUs' on the local clock */
+        uint64_t Normalize(uint64_t timestamp, uint64_t arrivalUs)
+        {
+            if (timestamp == 0)
+                return arrivalUs;
+
+            int64_t d = (int64_t)arrivalUs - (int64_t)(timestamp / TicksPerUs);
+            if (!_synced || d < _offset - ResyncUs || d > _offset + ResyncUs)
+            {
+                _offset = d;
+                _synced = true;
+            }
+            else
+            {
+                _offset = std::min(_offset + CreepUs, d);
+            }
+            return (uint64_t)((int64_t)(timestamp / TicksPerUs) + _offset);
+        }
+
+    private:
+        int64_t _offset = 0;
+        bool _synced = false;
+    };
+
+    /* Merges the frames of all feeders into one stream ordered by
+     * receive time.
+     *
+     * Every feeder has a jitter buffer kept sorted by time. Frames of one
+     * feeder arrive nearly in order, so inserting is a short shift from
+     * the back. A min-heap over the heads of the buffers picks the
+     * earliest frame of all feeders (k-way merge). A frame is released
+     * once it is 'latencyUs' old, which bounds the delay it adds. Heap
+     * entries are never updated in place: a buffer whose head changes
+     * pushes a new entry and bumps its version, so outdated entries are
+     * recognized and skipped when they come up.
+     *
+     * A full jitter buffer or staging area releases frames early, up to
+     * the one that makes room, so the output stays ordered. A frame older
+     * than the last one released can't be placed any more and is dropped,
+     * so the output is monotonic.
+     *
+     * Rows are staged in pages of MessageBatch allocated up to the peak
+     * backlog and reused after that, adding frames does not allocate.
+     * Only used from the main loop.
+     */
+    class Merge
+    {
+    public:
+        using MessageBatch = ssr::ads_b::transport::MessageBatch;
+
+        static constexpr uint32_t StreamCapacity = 256;
+        static constexpr uint32_t MaxRows = 1 << 15;
+
+        Merge(uint64_t latencyUs, std::function<void(const MessageBatch &)> emit) : _latency(latencyUs), _emit(std::move(emit))
+        {
+            _free.reserve(MaxRows);
+            _heap.reserve(1024);
+        }
+
+        /* Buffer all rows of 'batch' */
+        void Add(const MessageBatch &batch)
+        {
+            for (size_t i = 0; i < batch.size; i++)
+                add(batch, i);
+            flush();
+        }
+
+        /* Release every frame received before 'nowUs' - latency */
+        void Release(uint64_t nowUs)
+        {
+            if (nowUs > _latency)
+                releaseUntil(nowUs - _latency);
+            flush();
+        }
+
+        uint64_t Late() const { return _late; }       /* Frames dropped for arriving too late */
+        uint64_t Forced() const { return _forced; }   /* Frames released early for lack of room */
+        uint32_t Buffered() const { return _rows; }
+
+    private:
+        struct Pending
+        {
+            uint64_t time;
+            uint32_t slot;
+        };
+
+        /* Jitter buffer of one feeder, a ring sorted by time */
+        struct Stream
+        {
+            Pending items[StreamCapacity];
+            uint32_t head = 0;
+            uint32_t count = 0;
+            uint32_t version = 0;
+
+            Pending &at(uint32_t i) { return items[(head + i) % StreamCapacity]; }
+        };
+
+        struct HeapEntry
+        {
+            uint64_t time;
+            uint32_t stream;
+            uint32_t version;
+
+            bool operator>(const HeapEntry &o) const { return time > o.time; }
+        };
+
+        void add(const MessageBatch &batch, size_t i)
+        {
+            uint64_t time = batch.time[i];
+            if (time < _released)
+            {
+                _late++;
+                return;
+            }
+
+            uint32_t id = streamId(batch.source[i]);
+            if (_streams[id]->count == StreamCapacity)
+                makeRoom(_streams[id]->at(0).time);
+            while (_rows == MaxRows)
+                makeRoom(_heap.front().time);
+
+            /* Making room may have released frames later than this one */
+            if (time < _released)
+            {
+                _late++;
+                return;
+            }
+
+            uint32_t slot = allocSlot();
+            _pages[slot / MessageBatch::Capacity]->SetRow(slot % MessageBatch::Capacity, batch, i);
+
+            /* Insertion sort from the back, equal times keep their order */
+            Stream &s = *_streams[id];
+            uint32_t j = s.count++;
+            for (; j > 0 && s.at(j - 1).time > time; j--)
+                s.at(j) = s.at(j - 1);
+            s.at(j) = Pending{time, slot};
+
+            if (j == 0)
+                pushHead(id);
+        }
+
+        /* Release frames early, up to and including 'time' */
+        void makeRoom(uint64_t time)
+        {
+            uint32_t before = _rows;
+            releaseUntil(time);
+            _forced += before - _rows;
+        }
+
+        void releaseUntil(uint64_t watermark)
+        {
+            while (!_heap.empty() && _heap.front().time <= watermark)
+            {
+                HeapEntry e = _heap.front();
+                std::pop_heap(_heap.begin(), _heap.end(), std::greater<HeapEntry>());
+                _heap.pop_back();
+
+                Stream &s = *_streams[e.stream];
+                if (e.version != s.version || s.count == 0)
+                    continue; /* Outdated */
+
+                Pending p = s.at(0);
+                s.head = (s.head + 1) % StreamCapacity;
+                s.count--;
+                if (s.count > 0)
+                    pushHead(e.stream);
+
+                if (_out.Full())
+                    flush();
+                _out.Append(*_pages[p.slot / MessageBatch::Capacity], p.slot % MessageBatch::Capacity);
+                _released = p.time;
+                _free.push_back(p.slot);
+                _rows--;
+            }
+        }
+
+        void pushHead(uint32_t id)
+        {
+            Stream &s = *_streams[id];
+            _heap.push_back(HeapEntry{s.at(0).time, id, ++s.version});
+            std::push_heap(_heap.begin(), _heap.end(), std::greater<HeapEntry>());
+        }
+
+        uint32_t allocSlot()
+        {
+            _rows++;
+            if (_free.empty())
+            {
+                _pages.push_back(std::make_unique<MessageBatch>());
+                for (uint32_t i = MessageBatch::Capacity; i > 0; i--)
+                    _free.push_back((_pages.size() - 1) * MessageBatch::Capacity + i - 1);
+            }
+            uint32_t slot = _free.back();
+            _free.pop_back();
+            return slot;
+        }
+
+        /* Dense index of a feeder, sources are (lane << 16) | feeder id */
+        uint32_t streamId(uint32_t source)
+        {
+            uint32_t lane = source >> 16, feeder = source & 0xFFFF;
+            if (lane >= _index.size())
+                _index.resize(lane + 1);
+            auto &ids = _index[lane];
+            if (feeder >= ids.size())
+                ids.resize(feeder + 1, UINT32_MAX);
+            if (ids[feeder] == UINT32_MAX)
+            {
+                ids[feeder] = _streams.size();
+                _streams.push_back(std::make_unique<Stream>());
+            }
+            return ids[feeder];
+        }
+
+        void flush()
+        {
+            if (_out.size > 0)
+            {
+                _emit(_out);
+                _out.Clear();
+            }
+        }
+
+        uint64_t _latency;
+        std::function<void(const MessageBatch &)> _emit;
+
+        std::vector<std::unique_ptr<MessageBatch>> _pages;
+        std::vector<uint32_t> _free;
+        uint32_t _rows = 0;
+
+        std::vector<std::vector<uint32_t>> _index;
+        std::vector<std::unique_ptr<Stream>> _streams;
+        std::vector<HeapEntry> _heap;
+
+        MessageBatch _out;
+        uint64_t _released = 0;
+        uint64_t _late = 0;
+        uint64_t _forced = 0;
+    };
+
+} // namespace ssr::mixer
@@ -0,0 +1,242 @@
+#pragma once
+
+#include <uvw.hpp>
+#include <spdlog/spdlog.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <ads-b/modes.hpp>
+#include <mixer/shard.hpp>
+#include <mixer/merge.hpp>
+
+namespace ssr::mixer
+{
+    /* Mixer core, every input port pushes its raw frames here.
+     *
+     * Frames are routed by ICAO address to one of N shards, each decoding
+     * on its own thread, so the I/O loops only read and frame the input.
+     * Every I/O loop pushes through its own Input, so each shard ring has
+     * exactly one producer.
+     * Frames that fail the CRC are not forwarded and frames already seen
+     * from another feeder within the dedup window are dropped, so each
+     * unique squitter leaves the mixer once. Unique frames come back to
+     * the main loop in batches and are handed to every output, ordered by
+     * receive time when a merge latency is set.
+     */
+    class Mixer
+    {
+    public:
+        using RawFrame = ssr::ads_b::transport::RawFrame;
+        using MessageBatch = ssr::ads_b::transport::MessageBatch;
+        using Output = std::function<void(const MessageBatch &)>;
+
+        static constexpr uint32_t DedupCapacity = 1 << 16;
+        static constexpr uint32_t DedupWindowMs = 1000;
+        static constexpr uint32_t SelectCapacity = 1 << 14;
+        static constexpr uint32_t SelectHoldUs = 2000;
+        static constexpr uint32_t AircraftCapacity = 1 << 15;
+        static constexpr uint32_t AircraftTTLMs = 300 * 1000;
+
+        /* Producer side of the mixer for one I/O loop */
+        class Input
+        {
+        public:
+            Input(Mixer &mixer, uint32_t lane) : _mixer(mixer), _lane(lane) {}
+
+            /* Queue a frame for its shard, bit errors in 'frame' are fixed in
+             * place. Returns false if the shard is too far behind and the
+             * frame was dropped. */
+            bool Push(RawFrame &frame)
+            {
+                return _mixer._shards[_mixer.route(frame)]->Push(_lane, frame);
+            }
+
+            uint32_t Lane() const { return _lane; }
+
+            /* Hand the frames pushed since the last call to the workers,
+             * 'nowMs' is the loop time they were read at. */
+            void Flush(uint64_t nowMs)
+            {
+                _mixer._clock.store(nowMs, std::memory_order_relaxed);
+                for (auto &s : _mixer._shards)
+                    s->Wake(_lane);
+            }
+
+        private:
+            Mixer &_mixer;
+            uint32_t _lane;
+        };
+
+        /* 'workers' decode threads, the tables are split between them.
+         * 'inputs' is the number of I/O loops feeding the mixer.
+         * 'mergeLatencyMs' is how long frames are held back to put them in
+         * receive time order, 0 forwards them as they are decoded. */
+        Mixer(uint32_t workers, uint32_t inputs = 1, uint32_t mergeLatencyMs = 0) : _workers(workers ? workers : 1), _mergeLatencyMs(mergeLatencyMs)
+        {
+            for (uint32_t i = 0; i < (inputs ? inputs : 1); i++)
+                _inputs.push_back(std::make_unique<Input>(*this, i));
+        }
+
+        ~Mixer() { Stop(); }
+
+        /* Start the workers, their output is delivered on the main 'loop' */
+        void Init(uvw::Loop &loop)
+        {
+            _clock = loop.now().count();
+            _async = loop.resource<uvw::AsyncHandle>();
+            _async->on<uvw::AsyncEvent>([this](const uvw::AsyncEvent &, uvw::AsyncHandle &) {
+                this->Drain();
+            });
+
+            if (_mergeLatencyMs > 0)
+            {
+                _merge = std::make_unique<Merge>((uint64_t)_mergeLatencyMs * 1000, [this](const MessageBatch &batch) {
+                    for (auto &out : _outputs)
+                        out(batch);
+                });
+
+                /* Frames become due while no new ones arrive */
+                auto tick = uvw::TimerHandle::Time{std::max(1u, _mergeLatencyMs / 4)};
+                _timer = loop.resource<uvw::TimerHandle>();
+                _timer->on<uvw::TimerEvent>([this](const uvw::TimerEvent &, uvw::TimerHandle &) {
+                    _merge->Release(uv_hrtime() / 1000);
+                });
+                _timer->start(tick, tick);
+            }
+
+            for (uint32_t i = 0; i < _workers; i++)
+            {
+                _shards.push_back(std::make_unique<Shard>(i, _inputs.size(), split(DedupCapacity), DedupWindowMs, split(SelectCapacity), SelectHoldUs,
+                                                          split(AircraftCapacity), AircraftTTLMs, _clock, [this] { _async->send(); }));
+                _shards.back()->Start();
+            }
+            spdlog::info("Mixer started with {} decode workers", _workers);
+        }
+
+        void Stop()
+        {
+            for (auto &s : _shards)
+                s->Stop();
+        }
+
+        /* Forward unique frames to 'out', called on the loop thread */
+        void AddOutput(Output out) { _outputs.push_back(std::move(out)); }
+
+        /* Input for the I/O loop 'lane' */
+        Input &In(uint32_t lane = 0) { return *_inputs[lane]; }
+        uint32_t Inputs() const { return _inputs.size(); }
+
+        /* Forward the output of all workers, runs on the loop thread */
+        void Drain()
+        {
+            for (auto &s : _shards)
+            {
+                while (auto batch = s->Output())
+                {
+                    if (_merge)
+                    {
+                        _merge->Add(*batch);
+                    }
+                    else
+                    {
+                        for (auto &out : _outputs)
+                            out(*batch);
+                    }
+                    s->PopOutput();
+                }
+            }
+            if (_merge)
+                _merge->Release(uv_hrtime() / 1000);
+        }
+
+        uint64_t Unique() const { return sum(&ShardStats::unique); }
+        uint64_t Invalid() const { return sum(&ShardStats::frames) - sum(&ShardStats::crc_ok); }
+        uint64_t Corrected() const { return sum(&ShardStats::corrected); }
+        uint64_t Dropped() const { return sum(&ShardStats::dropped); }
+        uint64_t Replaced() const { return sum(&ShardStats::replaced); }
+        uint64_t Late() const { return _merge ? _merge->Late() : 0; }
+        uint64_t Duplicates() const
+        {
+            uint64_t n = 0;
+            for (auto &s : _shards)
+                n += s->Duplicates();
+            return n;
+        }
+
+    private:
+        /* Every frame of an address must reach the same shard. The address
+         * is in the clear for DF11/17/18 and DF19 with AF=0, and is the CRC
+         * syndrome for the address/parity formats, which is also what the
+         * shard's decoder checks against its whitelist. */
+        uint32_t route(RawFrame &frame) const
+        {
+            if (frame.len != 7 && frame.len != 14)
+                return 0;
+
+            check(frame);
+            if (_workers == 1)
+                return 0;
+
+            ssr::ads_b::transport::ModeSFrame f(frame.data, frame.len);
+            uint32_t icao = f.HasAddressField() ? f.IcaoAddress() : frame.syndrome;
+            return (uint32_t)(((uint64_t)(icao * 0x9E3779B1u) * _workers) >> 32);
+        }
+
+        /* Check the CRC and fix bit errors like the shard's decoder would,
+         * which then takes the result from the frame instead of doing the
+         * work again. Routing on the corrected AA field keeps a frame with
+         * a bit error in it on the same shard as its intact copies. */
+        static void check(RawFrame &frame)
+        {
+            using namespace ssr::ads_b::transport;
+
+            /* Sized by DF like the decoder does, short frames are zero padded */
+            int df = frame.data[0] >> 3;
+            int bits = df >= 16 ? MODES_LONG_MSG_BITS : MODES_SHORT_MSG_BITS;
+            memset(frame.data + frame.len, 0, sizeof(frame.data) - frame.len);
+            frame.len = std::max<uint8_t>(frame.len, bits / 8);
+
+            frame.syndrome = ModeSFrame(frame.data, bits / 8).Syndrome();
+            frame.errorbit = -1;
+            if (frame.syndrome != 0 && FIX_1_BIT_ERRORS && (df == 11 || df == 17 || df == 18))
+            {
+                int maxErrors = (FIX_2_BIT_ERRORS && df != 11) ? 2 : 1;
+                if ((frame.errorbit = FixBitErrors(frame.data, bits, frame.syndrome, maxErrors)) != -1)
+                    frame.syndrome = 0;
+            }
+            frame.checked = 1;
+        }
+
+        /* Per shard share of a table size */
+        uint32_t split(uint32_t capacity) const
+        {
+            uint32_t n = capacity / _workers;
+            return n < 1024 ? 1024 : n;
+        }
+
+        uint64_t sum(std::atomic<uint64_t> ShardStats::*field) const
+        {
+            uint64_t n = 0;
+            for (auto &s : _shards)
+                n += (s->Stats().*field).load(std::memory_order_relaxed);
+            return n;
+        }
+
+        uint32_t _workers;
+        std::vector<std::unique_ptr<Input>> _inputs;
+        std::vector<std::unique_ptr<Shard>> _shards;
+        std::atomic<uint64_t> _clock{0};
+        std::shared_ptr<uvw::AsyncHandle> _async;
+        std::vector<Output> _outputs;
+
+        uint32_t _mergeLatencyMs;
+        std::unique_ptr<Merge> _merge;
+        std::shared_ptr<uvw::TimerHandle> _timer;
+    };
+
+} // namespace ssr::mixer
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include <memory>
+
+namespace ssr::mixer
+{
+    /* Lock-free single producer / single consumer ring of 'Size' slots.
+     *
+     * Slots are allocated once and written in place: the producer fills
+     * the slot returned by Reserve() and makes it visible with Commit(),
+     * the consumer reads Front() and releases it with Pop(). Head and tail
+     * sit on their own cache lines and each side keeps a private copy of
+     * the other index, so the shared lines are only touched when the
+     * cached value says the ring looks full (or empty).
+     */
+    template <class T, size_t Size>
+    class SPSCRing
+    {
+        static_assert(Size > 1 && (Size & (Size - 1)) == 0, "Size must be a power of two");
+
+    public:
+        SPSCRing() : _slots(std::make_unique<T[]>(Size)) {}
+
+        /* Producer: next free slot, or nullptr if the ring is full */
+        T *Reserve()
+        {
+            size_t head = _head.load(std::memory_order_relaxed);
+            if (head - _tail_cache == Size)
+            {
+                _tail_cache = _tail.load(std::memory_order_acquire);
+                if (head - _tail_cache == Size)
+                    return nullptr;
+            }
+            return &_slots[head & (Size - 1)];
+        }
+
+        /* Producer: publish the slot returned by Reserve() */
+        void Commit()
+        {
+            _head.store(_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        bool Push(const T &v)
+        {
+            T *slot = Reserve();
+            if (!slot)
+                return false;
+            *slot = v;
+            Commit();
+            return true;
+        }
+
+        /* Consumer: oldest published slot, or nullptr if the ring is empty */
+        T *Front()
+        {
+            size_t tail = _tail.load(std::memory_order_relaxed);
+            if (tail == _head_cache)
+            {
+                _head_cache = _head.load(std::memory_order_acquire);
+                if (tail == _head_cache)
+                    return nullptr;
+            }
+            return &_slots[tail & (Size - 1)];
+        }
+
+        /* Consumer: release the slot returned by Front() */
+        void Pop()
+        {
+            _tail.store(_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        /* Either side, only a snapshot */
+        bool Empty() const
+        {
+            return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+        }
+
+    private:
+        std::unique_ptr<T[]> _slots;
+
+        alignas(64) std::atomic<size_t> _head{0}; /* Written by the producer */
+        size_t _tail_cache = 0;                    /* Producer's view of _tail */
+
+        alignas(64) std::atomic<size_t> _tail{0}; /* Written by the consumer */
+        size_t _head_cache = 0;                    /* Consumer's view of _head */
+    };
+
+} // namespace ssr::mixer
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <stdint.h>
+#include <memory>
+
+#include <ads-b/batch.hpp>
+#include <mixer/framekey.hpp>
+
+namespace ssr::mixer
+{
+    /* Holds the first copy of a frame for a short window and keeps the
+     * best copy that arrives from any feeder within it.
+     *
+     * A copy that needed no error correction beats a corrected one, and
+     * between those the higher signal level wins. Copies are matched on
+     * the message after error correction, so a corrected copy and a clean
+     * one compare equal.
+     *
+     * Frames hash to one bucket of 'Ways' slots, every slot owns a row of
+     * the staging batches. Since the hold window is the same for every
+     * frame, frames become due in the order they were held, which a ring
+     * of slot numbers keeps without sorting. When every slot of a bucket
+     * is taken the frame is not held and the caller forwards it as is.
+     *
+     * All memory is allocated up front, nothing here allocates.
+     */
+    class Select
+    {
+    public:
+        using MessageBatch = ssr::ads_b::transport::MessageBatch;
+
+        static constexpr int Ways = 4;
+
+        /* 'capacity' is rounded up to a power of two number of slots */
+        Select(uint32_t capacity, uint32_t holdUs) : _hold(holdUs)
+        {
+            _buckets = 1;
+            while (_buckets * Ways < capacity || _buckets * Ways < MessageBatch::Capacity)
+                _buckets <<= 1;
+            _slots = std::make_unique<Slot[]>(_buckets * Ways);
+            _queue = std::make_unique<uint32_t[]>(_buckets * Ways);
+            _rows = std::make_unique<MessageBatch[]>(_buckets * Ways / MessageBatch::Capacity);
+        }
+
+        /* If a copy of row 'i' is held, keep the better of the two and
+         * return true. */
+        bool Merge(const MessageBatch &batch, size_t i)
+        {
+            FrameKey key = keyOf(batch, i);
+            Slot *bucket = &_slots[(key.Hash() & (_buckets - 1)) * Ways];
+
+            for (int w = 0; w < Ways; w++)
+            {
+                Slot &s = bucket[w];
+                if (!s.held || !(s.key == key))
+                    continue;
+
+                uint32_t n = &s - _slots.get();
+                MessageBatch &rows = _rows[n / MessageBatch::Capacity];
+                size_t r = n % MessageBatch::Capacity;
+                if (better(batch, i, rows, r))
+                {
+                    rows.SetRow(r, batch, i);
+                    _replaced++;
+                }
+                _duplicates++;
+                return true;
+            }
+            return false;
+        }
+
+        /* Hold row 'i' until 'nowUs' + the window. Returns false when its
+         * bucket is full, the frame is not held then. */
+        bool Hold(const MessageBatch &batch, size_t i, uint64_t nowUs)
+        {
+            FrameKey key = keyOf(batch, i);
+            Slot *bucket = &_slots[(key.Hash() & (_buckets - 1)) * Ways];
+
+            for (int w = 0; w < Ways; w++)
+            {
+                Slot &s = bucket[w];
+                if (s.held)
+                    continue;
+
+                uint32_t n = &s - _slots.get();
+                s.key = key;
+                s.due = nowUs + _hold;
+                s.held = true;
+                _rows[n / MessageBatch::Capacity].SetRow(n % MessageBatch::Capacity, batch, i);
+                _queue[(_head + _count++) & (_buckets * Ways - 1)] = n;
+                return true;
+            }
+            _unheld++;
+            return false;
+        }
+
+        /* Calls 'fn(const MessageBatch &, size_t row)' for every frame whose
+         * window ended by 'nowUs', oldest first, and frees its slot. */
+        template <class TFn>
+        void Release(uint64_t nowUs, TFn &&fn)
+        {
+            while (_count > 0)
+            {
+                uint32_t n = _queue[_head];
+                Slot &s = _slots[n];
+                if (s.due > nowUs)
+                    break;
+
+                fn(_rows[n / MessageBatch::Capacity], n % MessageBatch::Capacity);
+                s.held = false;
+                _head = (_head + 1) & (_buckets * Ways - 1);
+                _count--;
+            }
+        }
+
+        uint32_t Pending() const { return _count; }
+
+        /* When the oldest held frame is due, only valid if Pending() */
+        uint64_t NextDue() const { return _slots[_queue[_head]].due; }
+
+        uint64_t Duplicates() const { return _duplicates; }
+        uint64_t Replaced() const { return _replaced; }
+        uint64_t Unheld() const { return _unheld; }
+
+    private:
+        static FrameKey keyOf(const MessageBatch &batch, size_t i)
+        {
+            return FrameKey(batch.msg[i], batch.msgbits[i] / 8);
+        }
+
+        struct Slot
+        {
+            FrameKey key;
+            uint64_t due = 0; /* Local time in us the window ends */
+            bool held = false;
+        };
+
+        /* Is row 'i' of 'a' a better copy than row 'j' of 'b' */
+        static bool better(const MessageBatch &a, size_t i, const MessageBatch &b, size_t j)
+        {
+            bool cleanA = a.errorbit[i] == -1, cleanB = b.errorbit[j] == -1;
+            if (cleanA != cleanB)
+                return cleanA;
+            return a.signal[i] > b.signal[j];
+        }
+
+        uint32_t _hold;
+        uint32_t _buckets;
+        std::unique_ptr<Slot[]> _slots;
+        std::unique_ptr<MessageBatch[]> _rows;
+
+        /* Held slots in the order they become due */
+        std::unique_ptr<uint32_t[]> _queue;
+        uint32_t _head = 0;
+        uint32_t _count = 0;
+
+        uint64_t _duplicates = 0;
+        uint64_t _replaced = 0;
+        uint64_t _unheld = 0;
+    };
+
+} // namespace ssr::mixer
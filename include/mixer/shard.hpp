@@ -0,0 +1,324 @@
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <ads-b/modes.hpp>
+#include <ads-b/aircraft.hpp>
+#include <mixer/dedup.hpp>
+#include <mixer/ring.hpp>
+#include <mixer/select.hpp>
+
+namespace ssr::mixer
+{
+    /* Counters of a shard, written by its worker and read from anywhere */
+    struct ShardStats
+    {
+        std::atomic<uint64_t> frames{0};    /* Frames decoded */
+        std::atomic<uint64_t> crc_ok{0};    /* Frames with a valid (or recovered) CRC */
+        std::atomic<uint64_t> corrected{0}; /* Frames fixed by error correction */
+        std::atomic<uint64_t> unique{0};    /* Frames forwarded after dedup */
+        std::atomic<uint64_t> dropped{0};   /* Frames lost to a full ring */
+        std::atomic<uint64_t> replaced{0};  /* Held frames replaced by a better copy */
+    };
+
+    /* One decode worker and the state of the ICAO addresses routed to it.
+     *
+     * Every I/O loop pushes raw frames into its own input lane, a single
+     * producer ring, and the worker thread decodes them in batches, drops
+     * invalid and duplicate frames, updates its aircraft and pushes the
+     * unique frames into the output ring for the main loop to forward.
+     * Each unique frame is held for a short window first, and a better
+     * copy from another feeder arriving within it takes its place (see
+     * Select). Since every frame of an address goes to the same
+     * shard, the decoder's ICAO whitelist, the dedup set and the aircraft
+     * table are only ever touched by one thread.
+     */
+    class Shard
+    {
+    public:
+        using RawFrame = ssr::ads_b::transport::RawFrame;
+        using MessageBatch = ssr::ads_b::transport::MessageBatch;
+
+        static constexpr size_t InputSize = 1 << 13;
+        static constexpr size_t OutputSize = 8;
+
+        /* 'clock' is the loop time in ms, published by the I/O loop.
+         * 'ready' is called from the worker when output was committed. */
+        Shard(uint32_t id, uint32_t lanes, uint32_t dedupCapacity, uint32_t dedupWindowMs, uint32_t selectCapacity, uint32_t selectHoldUs,
+              uint32_t aircraftCapacity, uint32_t aircraftTTLMs, const std::atomic<uint64_t> &clock, std::function<void()> ready)
+            : _id(id), _lanes(lanes), _dedup(dedupCapacity, dedupWindowMs), _select(selectCapacity, selectHoldUs),
+              _aircraft(aircraftCapacity, aircraftTTLMs), _clock(clock), _ready(std::move(ready))
+        {
+        }
+
+        ~Shard() { Stop(); }
+
+        void Start()
+        {
+            _running = true;
+            _thread = std::thread([this] { this->run(); });
+        }
+
+        void Stop()
+        {
+            if (!_thread.joinable())
+                return;
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                _running = false;
+            }
+            _wake.notify_one();
+            _thread.join();
+        }
+
+        /* I/O loop of 'lane': queue a frame, it is only seen by the worker
+         * after Wake(). Returns false (and counts a drop) if the ring is full. */
+        bool Push(uint32_t lane, const RawFrame &frame)
+        {
+            Lane &l = _lanes[lane];
+            if (!l.ring.Push(frame))
+            {
+                _stats.dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            l.pushed = true;
+            return true;
+        }
+
+        /* I/O loop of 'lane': wake the worker if frames were pushed since
+         * the last call and it went to sleep. */
+        void Wake(uint32_t lane)
+        {
+            Lane &l = _lanes[lane];
+            if (!l.pushed)
+                return;
+            l.pushed = false;
+
+            /* Pairs with the fence in run(): either the worker sees the new
+             * frames or we see it sleeping. */
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (_sleeping.load(std::memory_order_relaxed))
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                _wake.notify_one();
+            }
+        }
+
+        /* Main loop: oldest batch of unique frames, or nullptr */
+        const MessageBatch *Output() { return _out.Front(); }
+        void PopOutput() { _out.Pop(); }
+
+        uint32_t Id() const { return _id; }
+        const ShardStats &Stats() const { return _stats; }
+        uint64_t Duplicates() const { return _duplicates.load(std::memory_order_relaxed); }
+
+        /* Only safe to read from the worker, or once it stopped */
+        const ssr::ads_b::AircraftTable &Aircraft() const { return _aircraft; }
+
+    private:
+        static constexpr int SpinRounds = 1000;
+
+        void run()
+        {
+            int idle = 0;
+
+            while (_running.load(std::memory_order_relaxed))
+            {
+                size_t n = 0;
+                for (auto &l : _lanes)
+                {
+                    for (RawFrame *f; n < MessageBatch::Capacity && (f = l.ring.Front()); n++)
+                    {
+                        _pending[n] = *f;
+                        l.ring.Pop();
+                    }
+                }
+
+                if (n > 0)
+                {
+                    process(n);
+                    idle = 0;
+                    continue;
+                }
+                if (_select.Pending() > 0)
+                    release(nowUs());
+                if (++idle < SpinRounds)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(_lock);
+                _sleeping.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (empty() && _running)
+                {
+                    /* The timeout only bounds the cost of a missed wakeup,
+                     * or ends the window of the oldest held frame */
+                    std::chrono::microseconds timeout = std::chrono::milliseconds(100);
+                    if (_select.Pending() > 0)
+                    {
+                        uint64_t now = nowUs(), due = _select.NextDue();
+                        timeout = std::chrono::microseconds(due > now ? due - now : 0);
+                    }
+                    _wake.wait_for(lock, timeout);
+                }
+                _sleeping.store(false, std::memory_order_relaxed);
+                idle = 0;
+            }
+        }
+
+        bool empty() const
+        {
+            for (auto &l : _lanes)
+                if (!l.ring.Empty())
+                    return false;
+            return true;
+        }
+
+        /* Worker time for the hold window, independent of the loop clock */
+        static uint64_t nowUs()
+        {
+            using namespace std::chrono;
+            return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+        }
+
+        void process(size_t n)
+        {
+            uint64_t now = _clock.load(std::memory_order_relaxed);
+            uint64_t held = nowUs();
+
+            _batch.Clear();
+            _modes.setTime(now);
+            _modes.decodeBatch(_pending, n, _batch);
+
+            uint64_t crc_ok = 0, corrected = 0;
+            for (size_t i = 0; i < _batch.size; i++)
+            {
+                if (!_batch.crcok[i])
+                    continue;
+                crc_ok++;
+                corrected += _batch.errorbit[i] != -1 ? 1 : 0;
+
+                if (_select.Merge(_batch, i))
+                    continue;
+
+                auto frame = _batch.Frame(i);
+                if (_dedup.Seen(frame.Data(), frame.Bits() / 8, now))
+                    continue;
+
+                if (!_select.Hold(_batch, i, held))
+                    forward(_batch, i, now);
+            }
+            _aircraft.Expire(now, 64);
+
+            _stats.frames.fetch_add(_batch.size, std::memory_order_relaxed);
+            _stats.crc_ok.fetch_add(crc_ok, std::memory_order_relaxed);
+            _stats.corrected.fetch_add(corrected, std::memory_order_relaxed);
+
+            release(held);
+        }
+
+        /* Forward the frames whose hold window ended and commit the output */
+        void release(uint64_t nowUs)
+        {
+            uint64_t now = _clock.load(std::memory_order_relaxed);
+            _select.Release(nowUs, [&](const MessageBatch &rows, size_t r) { forward(rows, r, now); });
+
+            /* One line per batch, the logger is shared by all workers */
+            if (_unique > 0)
+                spdlog::debug("Mixed {} Mode-S messages (shard {}, {} held)", _unique, _id, _select.Pending());
+
+            _stats.unique.fetch_add(_unique, std::memory_order_relaxed);
+            _stats.replaced.store(_select.Replaced(), std::memory_order_relaxed);
+            _duplicates.store(_dedup.Duplicates() + _select.Duplicates(), std::memory_order_relaxed);
+            _unique = 0;
+
+            if (_reserved)
+            {
+                if (_reserved->size > 0)
+                {
+                    _out.Commit();
+                    _ready();
+                }
+                _reserved = nullptr;
+            }
+        }
+
+        void forward(const MessageBatch &rows, size_t r, uint64_t now)
+        {
+            _unique++;
+            ssr::ads_b::AircraftUpdate update = _aircraft.Update(rows, r, now);
+
+            if (!_reserved || _reserved->Full())
+            {
+                if (_reserved)
+                {
+                    _out.Commit();
+                    _ready();
+                }
+                if ((_reserved = _out.Reserve()))
+                    _reserved->Clear();
+            }
+            if (!_reserved)
+            {
+                _stats.dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            size_t o = _reserved->size;
+            _reserved->Append(rows, r);
+
+            /* Hand the position this message resolved on to the outputs */
+            if (update.position)
+            {
+                _reserved->position[o] = 1;
+                _reserved->lat[o] = update.aircraft->lat;
+                _reserved->lon[o] = update.aircraft->lon;
+            }
+        }
+
+        uint32_t _id;
+
+        /* Input from one I/O loop */
+        struct Lane
+        {
+            SPSCRing<RawFrame, InputSize> ring;
+            bool pushed = false; /* Only touched by the I/O loop */
+        };
+        std::vector<Lane> _lanes;
+
+        /* Worker state */
+        ssr::ads_b::transport::ModeS _modes;
+        Dedup _dedup;
+        Select _select;
+        ssr::ads_b::AircraftTable _aircraft;
+        RawFrame _pending[MessageBatch::Capacity];
+        MessageBatch _batch;
+
+        SPSCRing<MessageBatch, OutputSize> _out;
+        MessageBatch *_reserved = nullptr; /* Output being filled */
+        uint64_t _unique = 0;
+
+        const std::atomic<uint64_t> &_clock;
+        std::function<void()> _ready;
+        ShardStats _stats;
+        std::atomic<uint64_t> _duplicates{0};
+
+        std::thread _thread;
+        std::atomic<bool> _running{false};
+        std::atomic<bool> _sleeping{false};
+        std::mutex _lock;
+        std::condition_variable _wake;
+    };
+
+} // namespace ssr::mixer
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <ports/framer.hpp>
+#include <ports/feeder.hpp>
+#include <ads-b/modes.hpp>
+
+namespace ssr::ports
+{
+    struct BeastFeeder : Feeder {
+        BeastFramer framer;
+        uint64_t mode_ac = 0; /* Mode A/C frames, not decoded */
+    };
+
+    /* Mode-S Beast binary input.
+     *
+     * Frames are decoded straight from the unescaped payload, the MLAT
+     * timestamp and signal level are kept on the decoded message.
+     */
+    class Beast : public FeederPort<BeastFeeder> {
+    public:
+        Beast(uint16_t port, ssr::mixer::Mixer::Input &mixer) : FeederPort(port, "Beast", mixer) {
+
+        }
+
+    private:
+        void ParseData(BeastFeeder &feeder, const char *data, size_t len) override {
+            feeder.framer.Feed(data, len, [this, &feeder](const BeastFrame &frame) {
+                this->ParseFrame(feeder, frame);
+            });
+        }
+
+        void ParseFrame(BeastFeeder &feeder, const BeastFrame &frame) {
+            if(frame.type == BeastFrame::ModeAC) {
+                feeder.mode_ac++;
+                return;
+            }
+
+            ssr::ads_b::transport::RawFrame raw;
+            memcpy(raw.data, frame.data, frame.len);
+            raw.len = frame.len;
+            raw.signal = frame.signal;
+            raw.timestamp = frame.timestamp;
+            Queue(feeder, raw);
+        }
+    };
+
+} // namespace ssr::ports
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <memory>
+#include <vector>
+
+namespace ssr::ports
+{
+    /* Free list of fixed size socket read buffers.
+     *
+     * libuv asks for a buffer before every read and hands it back with the
+     * data. The framers copy what they keep, so a buffer is free again as
+     * soon as the read has been parsed and can go straight back on the
+     * list. Buffers are only allocated until the peak number in flight is
+     * reached (one per loop in practice), after that reads never allocate.
+     *
+     * Not thread safe, every loop uses its own pool.
+     */
+    class BufferPool
+    {
+    public:
+        /* What libuv suggests for a read */
+        static constexpr size_t BufferSize = 64 * 1024;
+
+        char *Acquire()
+        {
+            if (_free.empty())
+            {
+                _buffers.push_back(std::make_unique<char[]>(BufferSize));
+                _free.reserve(_buffers.size());
+                return _buffers.back().get();
+            }
+            char *buffer = _free.back();
+            _free.pop_back();
+            return buffer;
+        }
+
+        void Release(char *buffer)
+        {
+            _free.push_back(buffer);
+        }
+
+        /* Buffers allocated so far */
+        size_t Allocated() const { return _buffers.size(); }
+
+    private:
+        std::vector<std::unique_ptr<char[]>> _buffers;
+        std::vector<char *> _free;
+    };
+
+    /* Free list of objects, the same idea as BufferPool for state that
+     * lives while a request is in flight. Objects are not reset when
+     * they are reused. Not thread safe either.
+     */
+    template <class T>
+    class ObjectPool
+    {
+    public:
+        T *Acquire()
+        {
+            if (_free.empty())
+            {
+                _objects.push_back(std::make_unique<T>());
+                _free.reserve(_objects.size());
+                return _objects.back().get();
+            }
+            T *object = _free.back();
+            _free.pop_back();
+            return object;
+        }
+
+        void Release(T *object)
+        {
+            _free.push_back(object);
+        }
+
+        /* Objects allocated so far */
+        size_t Allocated() const { return _objects.size(); }
+
+    private:
+        std::vector<std::unique_ptr<T>> _objects;
+        std::vector<T *> _free;
+    };
+
+} // namespace ssr::ports
@@ -0,0 +1,239 @@
+#pragma once
+
+#include <uvw.hpp>
+#include <spdlog/spdlog.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include <memory>
+#include <vector>
+
+#include <ports/port.hpp>
+#include <ports/buffers.hpp>
+#include <ads-b/modes.hpp>
+#include <mixer/mixer.hpp>
+
+namespace ssr::ports
+{
+    /* Per feeder counters */
+    struct FeederStats {
+        uint64_t bytes = 0;     /* Bytes read from the socket */
+        uint64_t frames = 0;    /* Frames handed to the decoder */
+        uint64_t rejected = 0;  /* Frames the input could not parse */
+        uint64_t dropped = 0;   /* Frames lost because the decoders fell behind */
+    };
+
+    /* State kept for every connected feeder */
+    struct Feeder {
+        uint32_t id;
+        uvw::Addr peer;
+        FeederStats stats;
+        ssr::mixer::ClockSync clock; /* Receiver timestamps to local time */
+    };
+
+    /* Registry of connected feeders.
+     *
+     * Feeders are kept in a slot array indexed by their id, ids of
+     * disconnected feeders are reused so the array stays as large as the
+     * peak number of connections. Ids fit the 16 bits frames carry in
+     * their source, see FeederPort::Queue.
+     */
+    template <class TFeeder>
+    class FeederRegistry {
+    public:
+        static constexpr uint32_t MaxFeeders = 1 << 16;
+
+        /* Returns nullptr when MaxFeeders are connected */
+        TFeeder *Add() {
+            uint32_t id;
+            if (!_free.empty()) {
+                id = _free.back();
+                _free.pop_back();
+            } else if (_slots.size() < MaxFeeders) {
+                id = _slots.size();
+                _slots.emplace_back();
+            } else {
+                return nullptr;
+            }
+            _slots[id] = std::make_unique<TFeeder>();
+            _slots[id]->id = id;
+            _count++;
+            return _slots[id].get();
+        }
+
+        void Remove(uint32_t id) {
+            if (id < _slots.size() && _slots[id]) {
+                _slots[id].reset();
+                _free.push_back(id);
+                _count--;
+            }
+        }
+
+        TFeeder *Get(uint32_t id) const {
+            return id < _slots.size() ? _slots[id].get() : nullptr;
+        }
+
+        template <class TFn>
+        void ForEach(TFn &&fn) const {
+            for (auto &f : _slots) {
+                if (f) {
+                    fn(*f);
+                }
+            }
+        }
+
+        size_t Count() const { return _count; }
+
+    private:
+        std::vector<std::unique_ptr<TFeeder>> _slots;
+        std::vector<uint32_t> _free;
+        size_t _count = 0;
+    };
+
+    /* Base for input ports that accept any number of feeder connections.
+     *
+     * TFeeder is the per connection state (derived from Feeder) and must
+     * have a 'framer' member, the port implements ParseData to run it.
+     */
+    template <class TFeeder>
+    class FeederPort : public Port {
+    public:
+        FeederPort(uint16_t port, const char *name, ssr::mixer::Mixer::Input &mixer) : Port(port), _name(name), _mixer(mixer) {
+
+        }
+
+        void Init(uvw::Loop &loop) override {
+            /* The socket has to exist before bind to set SO_REUSEPORT, so
+             * create it up front by passing the address family. */
+            _tcp = _reuse ? loop.resource<uvw::TCPHandle>(AF_INET) : loop.resource<uvw::TCPHandle>();
+            if (_reuse) {
+                int on = 1;
+                int fd = _tcp->fd();
+                if (setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on)) != 0) {
+                    spdlog::error("{}[in] SO_REUSEPORT failed: {}", _name, strerror(errno));
+                }
+            }
+
+            _tcp->on<uvw::ErrorEvent>([this](const uvw::ErrorEvent &err, uvw::TCPHandle &) {
+                spdlog::error("{}[in] listen error: {}", this->_name, err.what());
+            });
+            _tcp->on<uvw::ListenEvent>([this](const uvw::ListenEvent &, uvw::TCPHandle &srv) {
+                this->Accept(srv);
+            });
+
+            _tcp->bind("0.0.0.0", _port);
+            _tcp->listen();
+            spdlog::debug("{}[in] started on {}", _name, _port);
+        }
+
+        const FeederRegistry<TFeeder> &Feeders() const {
+            return _feeders;
+        }
+
+    protected:
+        /* 'data' is only valid during the call */
+        virtual void ParseData(TFeeder &feeder, const char *data, size_t len) = 0;
+
+        /* Queue a frame for decoding, the decode workers pick up the frames
+         * of a read once it has been parsed completely. Stamps the frame
+         * with its feeder and receive time. */
+        void Queue(TFeeder &feeder, ssr::ads_b::transport::RawFrame &frame) {
+            frame.source = (_mixer.Lane() << 16) | feeder.id; /* Ids are below MaxFeeders */
+            frame.time = feeder.clock.Normalize(frame.timestamp, _readTime);
+            feeder.stats.frames++;
+            if(!_mixer.Push(frame)) {
+                feeder.stats.dropped++;
+            }
+        }
+
+        /* Account a frame the input could not parse to the feeder */
+        void Rejected(TFeeder &feeder) {
+            feeder.stats.frames++;
+            feeder.stats.rejected++;
+        }
+
+    private:
+        void Accept(uvw::TCPHandle &srv) {
+            std::shared_ptr<uvw::TCPHandle> client = srv.loop().resource<uvw::TCPHandle>();
+            srv.accept(*client);
+
+            TFeeder *added = _feeders.Add();
+            if (!added) {
+                spdlog::warn("{}[in] feeder limit reached, rejecting {}", _name, client->peer().ip);
+                client->close();
+                return;
+            }
+            auto &feeder = *added;
+            feeder.peer = client->peer();
+
+            /* Listeners are registered once per connection and only capture
+             * the port and the feeder slot, which stays valid until close. */
+            client->on<uvw::ErrorEvent>([](const uvw::ErrorEvent &err, uvw::TCPHandle &client) {
+                spdlog::debug("Client error {}:{} {}", client.peer().ip, client.peer().port, err.what());
+                client.close();
+            });
+            client->on<uvw::CloseEvent>([this, id = feeder.id](const uvw::CloseEvent &, uvw::TCPHandle &) {
+                this->Disconnect(id);
+            });
+
+            /* Read with our own callbacks instead of client->read(), which
+             * allocates a new buffer for every read and hands it out in a
+             * DataEvent. The uvw handle stays the handle's data pointer, the
+             * reader is kept as its user data. */
+            client->data(std::make_shared<Reader>(Reader{this, &feeder}));
+            uv_read_start((uv_stream_t *)client->raw(), &FeederPort::allocBuffer, &FeederPort::onRead);
+            spdlog::debug("New client connected {}[{}] << {}:{} ({} feeders)", _name, _port, feeder.peer.ip, feeder.peer.port, _feeders.Count());
+        }
+
+        struct Reader {
+            FeederPort *port;
+            TFeeder *feeder;
+        };
+
+        static void allocBuffer(uv_handle_t *handle, size_t, uv_buf_t *buf) {
+            auto &client = *static_cast<uvw::TCPHandle *>(handle->data);
+            auto *port = client.data<Reader>()->port;
+            *buf = uv_buf_init(port->_buffers.Acquire(), BufferPool::BufferSize);
+        }
+
+        static void onRead(uv_stream_t *stream, ssize_t nread, const uv_buf_t *buf) {
+            auto &client = *static_cast<uvw::TCPHandle *>(stream->data);
+            auto reader = client.data<Reader>();
+            FeederPort *port = reader->port;
+
+            if (nread > 0) {
+                port->_readTime = uv_hrtime() / 1000;
+                reader->feeder->stats.bytes += nread;
+                port->ParseData(*reader->feeder, buf->base, nread);
+                port->_mixer.Flush(port->_tcp->loop().now().count());
+            } else if (nread < 0) {
+                if (nread != UV_EOF) {
+                    spdlog::debug("Client error {}:{} {}", client.peer().ip, client.peer().port, uv_strerror(nread));
+                }
+                client.close();
+            }
+
+            if (buf->base) {
+                port->_buffers.Release(buf->base);
+            }
+        }
+
+        void Disconnect(uint32_t id) {
+            if (auto f = _feeders.Get(id)) {
+                spdlog::debug("Client disconnected {}:{} bytes={} frames={} rejected={} dropped={} unframed={}",
+                              f->peer.ip, f->peer.port, f->stats.bytes, f->stats.frames, f->stats.rejected,
+                              f->stats.dropped, f->framer.Dropped());
+            }
+            _feeders.Remove(id);
+        }
+
+        const char *_name;
+        ssr::mixer::Mixer::Input &_mixer;
+        FeederRegistry<TFeeder> _feeders;
+        BufferPool _buffers;
+        uint64_t _readTime = 0; /* Local time of the read being parsed, us */
+    };
+
+} // namespace ssr::ports
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <stdint.h>
+#include <string_view>
+#include <memory.h>
+
+#include <util.hpp>
+
+namespace ssr::ports
+{
+    /* Splits a TCP byte stream into newline terminated lines.
+     *
+     * Complete lines are handed out as views into the read buffer, only a
+     * trailing partial line is copied into the internal buffer and joined
+     * with the start of the next read. Lines longer than the internal
+     * buffer are dropped up to the next newline.
+     */
+    class LineFramer
+    {
+    public:
+        static constexpr uint16_t MaxLine = 256;
+
+        /* Calls 'onLine(std::string_view)' for every complete, non empty
+         * line in 'data', without the line terminator. */
+        template <class TFn>
+        void Feed(const char *data, size_t len, TFn &&onLine)
+        {
+            std::string_view in(data, len);
+            size_t prev = 0, pos;
+
+            /* Finish the line carried over from the previous read */
+            if (_len != 0 || _discard)
+            {
+                if ((pos = in.find('\n')) == std::string_view::npos)
+                {
+                    carry(in);
+                    return;
+                }
+                carry(in.substr(0, pos));
+                if (!_discard)
+                    emit(std::string_view(_buffer, _len), onLine);
+                _len = 0;
+                _discard = false;
+                prev = pos + 1;
+            }
+
+            while ((pos = in.find('\n', prev)) != std::string_view::npos)
+            {
+                emit(in.substr(prev, pos - prev), onLine);
+                prev = pos + 1;
+            }
+
+            if (prev < in.length())
+                carry(in.substr(prev));
+        }
+
+        /* Forget any partial line, e.g. when the connection is reset */
+        void Reset()
+        {
+            _len = 0;
+            _discard = false;
+        }
+
+        /* Number of lines dropped for exceeding MaxLine */
+        uint32_t Dropped() const { return _dropped; }
+
+    private:
+        template <class TFn>
+        static void emit(std::string_view line, TFn &onLine)
+        {
+            if (!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+            if (!line.empty())
+                onLine(line);
+        }
+
+        void carry(std::string_view part)
+        {
+            if (_discard)
+                return;
+            if (_len + part.length() > MaxLine)
+            {
+                _dropped++;
+                _discard = true;
+                _len = 0;
+                return;
+            }
+            memcpy(_buffer + _len, part.data(), part.length());
+            _len += part.length();
+        }
+
+        char _buffer[MaxLine]; //internal buffer for incomplete messages
+        uint16_t _len = 0;
+        bool _discard = false;
+        uint32_t _dropped = 0;
+    };
+
+    /* A frame in Mode-S Beast binary format, the payload points into the
+     * framer and is only valid during the callback. */
+    struct BeastFrame
+    {
+        static constexpr char ModeAC = '1';
+        static constexpr char ModeSShort = '2';
+        static constexpr char ModeSLong = '3';
+
+        char type;
+        uint64_t timestamp; /* 48 bit MLAT counter */
+        uint8_t signal;     /* Signal level */
+        const unsigned char *data;
+        uint8_t len;
+    };
+
+    /* Splits a TCP byte stream into Mode-S Beast frames.
+     *
+     * Every frame is: 0x1A, type, 6 byte timestamp, 1 byte signal level and
+     * 2 (Mode A/C), 7 (short Mode S) or 14 (long Mode S) bytes of payload.
+     * A 0x1A inside a frame is sent twice. Frames are unescaped into the
+     * internal buffer, which also carries a partial frame over to the next
+     * read. Unknown types and broken escapes drop the frame and resync on
+     * the next 0x1A.
+     */
+    class BeastFramer
+    {
+    public:
+        static constexpr uint8_t Escape = 0x1A;
+
+        /* Calls 'onFrame(const BeastFrame &)' for every complete frame */
+        template <class TFn>
+        void Feed(const char *data, size_t len, TFn &&onFrame)
+        {
+            const unsigned char *p = (const unsigned char *)data;
+            const unsigned char *end = p + len;
+
+            while (p < end)
+            {
+                switch (_state)
+                {
+                case State::Sync:
+                    if ((p = (const unsigned char *)memchr(p, Escape, end - p)) == nullptr)
+                        return;
+                    p++;
+                    _state = State::Type;
+                    break;
+
+                case State::Type:
+                    start(*p++);
+                    break;
+
+                case State::Body:
+                    if (*p == Escape)
+                    {
+                        p++;
+                        _state = State::Escaped;
+                        break;
+                    }
+                    _buffer[_len++] = *p++;
+                    break;
+
+                case State::Escaped:
+                    if (*p != Escape)
+                    {
+                        /* Lone 0x1A, the frame was cut short and this is the
+                         * start of the next one. */
+                        _dropped++;
+                        start(*p++);
+                        break;
+                    }
+                    _buffer[_len++] = *p++;
+                    _state = State::Body;
+                    break;
+                }
+
+                if (_state == State::Body && _len == _need)
+                {
+                    BeastFrame frame;
+                    frame.type = _type;
+                    frame.timestamp = ssr::__u48((const char *)_buffer);
+                    frame.signal = _buffer[6];
+                    frame.data = _buffer + 7;
+                    frame.len = _need - 7;
+                    onFrame(frame);
+                    _state = State::Sync;
+                }
+            }
+        }
+
+        /* Forget any partial frame, e.g. when the connection is reset */
+        void Reset()
+        {
+            _state = State::Sync;
+        }
+
+        /* Number of frames dropped for bad framing */
+        uint32_t Dropped() const { return _dropped; }
+
+    private:
+        enum class State : uint8_t
+        {
+            Sync,
+            Type,
+            Body,
+            Escaped
+        };
+
+        void start(unsigned char type)
+        {
+            _len = 0;
+            _type = type;
+            _state = State::Body;
+            switch (type)
+            {
+            case BeastFrame::ModeAC:
+                _need = 7 + 2;
+                break;
+            case BeastFrame::ModeSShort:
+                _need = 7 + 7;
+                break;
+            case BeastFrame::ModeSLong:
+                _need = 7 + 14;
+                break;
+            default:
+                /* Status frames ('4') or garbage, wait for the next frame */
+                if (type != Escape && type != '4')
+                    _dropped++;
+                _state = State::Sync;
+                break;
+            }
+        }
+
+        unsigned char _buffer[7 + 14];
+        uint8_t _len = 0;
+        uint8_t _need = 0;
+        char _type = 0;
+        State _state = State::Sync;
+        uint32_t _dropped = 0;
+    };
+
+} // namespace ssr::ports
@@ -5,6 +5,8 @@
 #include <stdint.h>
 #include <memory>
 
+#include <ads-b/batch.hpp>
+
 namespace ssr::ports
 {
     class Port {
@@ -13,12 +15,18 @@ namespace ssr::ports
         
         virtual void Init(uvw::Loop &loop) = 0;
 
-        template<class Tmsg>
-        void Mix(Tmsg msg);
+        /* Bind with SO_REUSEPORT so several loops can listen on the same
+         * port and the kernel spreads connections between them. */
+        void ReusePort(bool reuse) { _reuse = reuse; }
+
+        /* Output ports: send a batch of mixed frames, called on the loop
+         * the port was initialized on. Input ports ignore it. */
+        virtual void Mix(const ssr::ads_b::transport::MessageBatch &) {}
 
         protected:
             uint16_t _port;
             std::shared_ptr<uvw::TCPHandle> _tcp;
+            bool _reuse = false;
     };
 
 } // namespace ssr::ports
\ No newline at end of file
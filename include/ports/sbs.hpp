@@ -0,0 +1,469 @@
+#pragma once
+
+#include <uvw.hpp>
+#include <spdlog/spdlog.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <ports/port.hpp>
+#include <ports/buffers.hpp>
+#include <ads-b/batch.hpp>
+
+namespace ssr::ports
+{
+    /* Appends text to a buffer the caller sized for the worst case, so
+     * nothing is bounds checked, allocated or locale dependent. Numbers
+     * are written two digits at a time from a table into a scratch area
+     * and copied out, the only branches are on the number of digit pairs.
+     */
+    class TextWriter {
+    public:
+        explicit TextWriter(char *out) : _p(out) {}
+
+        char *Pos() const { return _p; }
+
+        void Char(char c) { *_p++ = c; }
+
+        void Text(const char *s, size_t len) {
+            memcpy(_p, s, len);
+            _p += len;
+        }
+
+        template <size_t N>
+        void Text(const char (&s)[N]) { Text(s, N - 1); }
+
+        /* Decimal without padding */
+        void Uint(uint32_t v) { digits(v, Digits(v)); }
+
+        void Int(int32_t v) {
+            *_p = '-';
+            _p += v < 0;
+            Uint(v < 0 ? 0u - (uint32_t)v : (uint32_t)v);
+        }
+
+        /* Exactly 'width' digits, zero padded, 'v' must fit */
+        void Padded(uint32_t v, int width) { digits(v, width); }
+
+        /* Fixed point with 'decimals' (1-9) fraction digits */
+        void Fixed(double v, int decimals) {
+            int64_t scaled = llrint(v * Pow10[decimals]);
+            *_p = '-';
+            _p += scaled < 0;
+            uint64_t u = scaled < 0 ? 0 - (uint64_t)scaled : (uint64_t)scaled;
+            Uint((uint32_t)(u / Pow10[decimals]));
+            Char('.');
+            Padded((uint32_t)(u % Pow10[decimals]), decimals);
+        }
+
+        /* 24 bit address as 6 upper case hex digits */
+        void Hex24(uint32_t v) {
+            for (int i = 5; i >= 0; i--, v >>= 4)
+                _p[i] = "0123456789ABCDEF"[v & 0xF];
+            _p += 6;
+        }
+
+        static constexpr int Digits(uint32_t v) {
+            return 1 + (v >= 10) + (v >= 100) + (v >= 1000) + (v >= 10000) + (v >= 100000) + (v >= 1000000) +
+                   (v >= 10000000) + (v >= 100000000) + (v >= 1000000000);
+        }
+
+    private:
+        static constexpr uint64_t Pow10[10] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+        static constexpr char Pairs[] =
+            "0001020304050607080910111213141516171819"
+            "2021222324252627282930313233343536373839"
+            "4041424344454647484950515253545556575859"
+            "6061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+
+        /* The last 'n' digits of 'v' */
+        void digits(uint32_t v, int n) {
+            char scratch[10];
+            char *q = scratch + sizeof(scratch);
+            for (int i = 0; i < n; i += 2, v /= 100) {
+                q -= 2;
+                memcpy(q, &Pairs[(v % 100) * 2], 2);
+            }
+            Text(scratch + sizeof(scratch) - n, n);
+        }
+
+        char *_p;
+    };
+
+    /* BaseStation (SBS-1) output, the CSV stream on port 30003 that many
+     * legacy tools read.
+     *
+     * Every batch of mixed frames is formatted once into a chunk and the
+     * same chunk is written to all clients with uv_write. The chunk counts
+     * the writes in flight and goes back to the pool when the last one
+     * completes, so a batch costs one formatting pass plus one write per
+     * client, and once the pools reached their peak nothing is allocated.
+     * A client whose write queue grew past MaxQueued misses chunks until
+     * it caught up, a slow consumer can't make us buffer without bound.
+     *
+     * Clients are only ever written to, what they send is discarded.
+     */
+    class SBS : public Port {
+    public:
+        using MessageBatch = ssr::ads_b::transport::MessageBatch;
+
+        /* Longest line we render, a MSG,3 with every field at its widest */
+        static constexpr size_t MaxLine = 160;
+        static constexpr size_t MaxQueued = 1 << 20;
+
+        SBS(uint16_t port) : Port(port) {
+
+        }
+
+        void Init(uvw::Loop &loop) override {
+            _tcp = loop.resource<uvw::TCPHandle>();
+
+            _tcp->on<uvw::ErrorEvent>([](const uvw::ErrorEvent &err, uvw::TCPHandle &) {
+                spdlog::error("SBS[out] listen error: {}", err.what());
+            });
+            _tcp->on<uvw::ListenEvent>([this](const uvw::ListenEvent &, uvw::TCPHandle &srv) {
+                this->Accept(srv);
+            });
+
+            _tcp->bind("0.0.0.0", _port);
+            _tcp->listen();
+            spdlog::debug("SBS[out] started on {}", _port);
+        }
+
+        void Mix(const MessageBatch &batch) override {
+            if (_clients.empty() || batch.size == 0)
+                return;
+
+            Chunk *chunk = _chunks.Acquire();
+            chunk->size = render(batch, chunk->data);
+            if (chunk->size == 0) {
+                _chunks.Release(chunk);
+                return;
+            }
+
+            /* Our own reference keeps the chunk while writes complete */
+            chunk->refs = 1;
+            for (auto &client : _clients)
+                send(*client, chunk);
+            unref(chunk);
+        }
+
+        size_t Clients() const { return _clients.size(); }
+
+        /* Chunks not sent to clients that fell behind */
+        uint64_t Skipped() const { return _skipped; }
+
+    private:
+        struct Chunk {
+            uint32_t refs;
+            size_t size;
+            char data[MessageBatch::Capacity * MaxLine];
+        };
+
+        struct Write {
+            uv_write_t req;
+            Chunk *chunk;
+            SBS *port;
+        };
+
+        /* User data of a client handle */
+        struct Subscriber {
+            SBS *port;
+        };
+
+        void Accept(uvw::TCPHandle &srv) {
+            std::shared_ptr<uvw::TCPHandle> client = srv.loop().resource<uvw::TCPHandle>();
+            srv.accept(*client);
+
+            client->on<uvw::ErrorEvent>([](const uvw::ErrorEvent &err, uvw::TCPHandle &client) {
+                spdlog::debug("Client error {}:{} {}", client.peer().ip, client.peer().port, err.what());
+                client.close();
+            });
+            client->on<uvw::CloseEvent>([this](const uvw::CloseEvent &, uvw::TCPHandle &client) {
+                this->Disconnect(client);
+            });
+
+            /* Only read to notice the client going away, see FeederPort
+             * for why the callbacks are installed directly */
+            client->data(std::make_shared<Subscriber>(Subscriber{this}));
+            uv_read_start((uv_stream_t *)client->raw(), &SBS::allocDiscard, &SBS::onRead);
+
+            _clients.push_back(std::move(client));
+            spdlog::debug("New client connected SBS[{}] >> {}:{} ({} clients)", _port, _clients.back()->peer().ip,
+                          _clients.back()->peer().port, _clients.size());
+        }
+
+        void Disconnect(uvw::TCPHandle &client) {
+            for (size_t i = 0; i < _clients.size(); i++) {
+                if (_clients[i].get() == &client) {
+                    _clients[i] = std::move(_clients.back());
+                    _clients.pop_back();
+                    break;
+                }
+            }
+            spdlog::debug("Client disconnected SBS[{}] ({} clients)", _port, _clients.size());
+        }
+
+        static void allocDiscard(uv_handle_t *handle, size_t, uv_buf_t *buf) {
+            auto &client = *static_cast<uvw::TCPHandle *>(handle->data);
+            auto *port = client.data<Subscriber>()->port;
+            *buf = uv_buf_init(port->_discard, sizeof(port->_discard));
+        }
+
+        static void onRead(uv_stream_t *stream, ssize_t nread, const uv_buf_t *) {
+            auto &client = *static_cast<uvw::TCPHandle *>(stream->data);
+            if (nread < 0 && !client.closing())
+                client.close();
+        }
+
+        void send(uvw::TCPHandle &client, Chunk *chunk) {
+            uv_stream_t *stream = (uv_stream_t *)client.raw();
+            if (client.closing() || client.writeQueueSize() > MaxQueued) {
+                _skipped++;
+                return;
+            }
+
+            Write *w = _writes.Acquire();
+            w->chunk = chunk;
+            w->port = this;
+            w->req.data = w;
+
+            uv_buf_t buf = uv_buf_init(chunk->data, chunk->size);
+            int err = uv_write(&w->req, stream, &buf, 1, &SBS::onWrite);
+            if (err != 0) {
+                spdlog::debug("Client error {}:{} {}", client.peer().ip, client.peer().port, uv_strerror(err));
+                _writes.Release(w);
+                client.close();
+                return;
+            }
+            chunk->refs++;
+        }
+
+        static void onWrite(uv_write_t *req, int status) {
+            Write *w = static_cast<Write *>(req->data);
+            SBS *port = w->port;
+
+            /* Cancelled writes of a closing client end up here as well */
+            if (status < 0 && status != UV_ECANCELED) {
+                auto &client = *static_cast<uvw::TCPHandle *>(req->handle->data);
+                if (!client.closing())
+                    client.close();
+            }
+
+            port->unref(w->chunk);
+            port->_writes.Release(w);
+        }
+
+        void unref(Chunk *chunk) {
+            if (--chunk->refs == 0)
+                _chunks.Release(chunk);
+        }
+
+        /* Render every row of 'batch' as a BaseStation MSG line, returns
+         * the number of bytes written to 'out'. */
+        size_t render(const MessageBatch &batch, char *out) {
+            using namespace std::chrono;
+
+            /* Receive times are on the loop's monotonic clock (uv_hrtime),
+             * mapped to wall time through a single pair of readings. */
+            uint64_t monoUs = uv_hrtime() / 1000;
+            uint64_t wallUs = duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+
+            TextWriter w(out);
+            for (size_t i = 0; i < batch.size; i++) {
+                int type = msgType(batch, i);
+                if (type == 0)
+                    continue;
+
+                uint64_t t = batch.time[i];
+                uint64_t generatedUs = t != 0 && t <= monoUs ? wallUs - (monoUs - t) : wallUs;
+
+                w.Text("MSG,");
+                w.Char('0' + type);
+                w.Text(",1,1,");
+                w.Hex24(batch.icao[i]);
+                w.Text(",1,");
+                stamp(w, generatedUs / 1000);
+                w.Char(',');
+                stamp(w, wallUs / 1000);
+                fields(w, type, batch, i);
+                w.Text("\r\n");
+            }
+            return w.Pos() - out;
+        }
+
+        /* BaseStation transmission type of row 'i', 0 to skip it */
+        static int msgType(const MessageBatch &batch, size_t i) {
+            switch (batch.df[i]) {
+            case 0:
+            case 16:
+                return 7; /* Air to air */
+            case 4:
+            case 20:
+                return 5; /* Surveillance altitude */
+            case 5:
+            case 21:
+                return 6; /* Surveillance ID */
+            case 11:
+                return 8; /* All call reply */
+            case 17:
+            case 18: {
+                int tc = batch.metype[i];
+                if (tc >= 1 && tc <= 4)
+                    return 1; /* Identification */
+                if ((tc >= 9 && tc <= 18) || (tc >= 20 && tc <= 22))
+                    return 3; /* Airborne position */
+                if (tc == 19 && (batch.mesub[i] == 1 || batch.mesub[i] == 2) && batch.velocity_valid[i])
+                    return 4; /* Airborne velocity over ground */
+                return 0;
+            }
+            default:
+                return 0;
+            }
+        }
+
+        /* The 12 fields after the timestamps: callsign, altitude, ground
+         * speed, track, lat, lon, vertical rate, squawk, alert, emergency,
+         * SPI and on ground. Flags are -1 when set. */
+        static void fields(TextWriter &w, int type, const MessageBatch &batch, size_t i) {
+            switch (type) {
+            case 1: {
+                /* Callsigns are space padded to 8 characters */
+                size_t len = strnlen(batch.flight[i], 8);
+                while (len > 0 && batch.flight[i][len - 1] == ' ')
+                    len--;
+                w.Char(',');
+                w.Text(batch.flight[i], len);
+                w.Text(",,,,,,,,,,,");
+                break;
+            }
+            case 3:
+                w.Text(",,");
+                altitude(w, batch, i);
+                w.Text(",,,");
+                if (batch.position[i]) {
+                    w.Fixed(batch.lat[i], 5);
+                    w.Char(',');
+                    w.Fixed(batch.lon[i], 5);
+                } else {
+                    w.Char(',');
+                }
+                w.Text(",,,0,0,0,0");
+                break;
+            case 4:
+                w.Text(",,,");
+                w.Int(batch.velocity[i]);
+                w.Char(',');
+                if (batch.heading_valid[i])
+                    w.Int(batch.heading[i]);
+                w.Text(",,,");
+                w.Int(batch.vert_rate[i]);
+                w.Text(",,0,0,0,0");
+                break;
+            case 5:
+                w.Text(",,");
+                altitude(w, batch, i);
+                w.Text(",,,,,,,");
+                status(w, batch.ca[i], false);
+                break;
+            case 6: {
+                uint16_t squawk = batch.identity[i];
+                w.Text(",,,,,,,,");
+                w.Padded(squawk, 4);
+                w.Char(',');
+                status(w, batch.ca[i], squawk == 7500 || squawk == 7600 || squawk == 7700);
+                break;
+            }
+            case 7:
+                w.Text(",,");
+                altitude(w, batch, i);
+                w.Text(",,,,,,,,,,");
+                break;
+            default:
+                w.Text(",,,,,,,,,,,,");
+                break;
+            }
+        }
+
+        /* SBS altitudes are in feet, metric ones (GNSS height and AC fields
+         * with the M bit set) are converted */
+        static void altitude(TextWriter &w, const MessageBatch &batch, size_t i) {
+            if (batch.unit[i] == MODES_UNIT_METERS)
+                w.Int((batch.altitude[i] * 3281 + 500) / 1000);
+            else
+                w.Int(batch.altitude[i]);
+        }
+
+        /* Alert, emergency, SPI and on ground from the flight status of
+         * DF4/5/20/21 */
+        static void status(TextWriter &w, uint8_t fs, bool emergency) {
+            bool alert = fs >= 2 && fs <= 4;
+            bool spi = fs == 4 || fs == 5;
+            bool ground = fs == 1 || fs == 3;
+            flag(w, alert);
+            w.Char(',');
+            flag(w, emergency);
+            w.Char(',');
+            flag(w, spi);
+            w.Char(',');
+            flag(w, ground);
+        }
+
+        static void flag(TextWriter &w, bool set) {
+            if (set)
+                w.Text("-1");
+            else
+                w.Char('0');
+        }
+
+        /* Local "yyyy/mm/dd,hh:mm:ss.mmm" of 'ms' since the epoch. The date
+         * and hour only change once an hour, they are cached and rendered
+         * again when 'ms' leaves the hour they were rendered for. */
+        void stamp(TextWriter &w, uint64_t ms) {
+            if (ms < _hourStart || ms >= _hourStart + 3600 * 1000)
+                hour(ms);
+
+            uint32_t t = ms - _hourStart;
+            w.Text(_hour, sizeof(_hour));
+            w.Padded(t / 60000, 2);
+            w.Char(':');
+            w.Padded(t / 1000 % 60, 2);
+            w.Char('.');
+            w.Padded(t % 1000, 3);
+        }
+
+        void hour(uint64_t ms) {
+            time_t s = ms / 1000;
+            struct tm tm;
+            localtime_r(&s, &tm);
+            _hourStart = ms - ((tm.tm_min * 60 + tm.tm_sec) * 1000ull + ms % 1000);
+
+            TextWriter w(_hour);
+            w.Padded(tm.tm_year + 1900, 4);
+            w.Char('/');
+            w.Padded(tm.tm_mon + 1, 2);
+            w.Char('/');
+            w.Padded(tm.tm_mday, 2);
+            w.Char(',');
+            w.Padded(tm.tm_hour, 2);
+            w.Char(':');
+        }
+
+        std::vector<std::shared_ptr<uvw::TCPHandle>> _clients;
+        ObjectPool<Chunk> _chunks;
+        ObjectPool<Write> _writes;
+        uint64_t _skipped = 0;
+
+        char _discard[256];
+        uint64_t _hourStart = 0;
+        char _hour[14]; /* "yyyy/mm/dd,hh:" */
+    };
+
+} // namespace ssr::ports
@@ -1,134 +1,63 @@
 #include <ads-b/modes.hpp>
 
+#include <array>
+#include <utility>
+
 namespace ssr::ads_b::transport
 {
     uint32_t ModeS::modesChecksum(unsigned char *msg, int bits)
     {
-        uint32_t crc = 0;
-        int offset = (bits == 112) ? 0 : (112 - 56);
-        int j;
-
-        for (j = 0; j < bits; j++)
-        {
-            int byte = j / 8;
-            int bit = j % 8;
-            int bitmask = 1 << (7 - bit);
-
-            /* If bit is set, xor with corresponding table entry. */
-            if (msg[byte] & bitmask)
-                crc ^= modes_checksum_table[j + offset];
-        }
-        return crc; /* 24 bit checksum. */
+        return CRC24::MessageChecksum(msg, bits); /* 24 bit checksum. */
     }
 
     int ModeS::modesMessageLenByType(int type)
     {
-        if (type == 16 || type == 17 ||
-            type == 19 || type == 20 ||
-            type == 21)
+        /* DF16 and up are long, including DF18 and DF24 (Comm-D) */
+        if (type >= 16)
             return MODES_LONG_MSG_BITS;
         else
             return MODES_SHORT_MSG_BITS;
     }
 
-    int ModeS::fixSingleBitErrors(unsigned char *msg, int bits)
+    /* Every 1 and 2 bit error syndrome, built at compile time. */
+    static constexpr CRC24Syndromes syndromes;
+
+    int FixBitErrors(unsigned char *msg, int bits, uint32_t syndrome, int maxErrors)
     {
-        int j;
-        unsigned char aux[MODES_LONG_MSG_BITS / 8];
+        int errorbit = syndromes.Lookup(syndrome, bits, maxErrors);
 
-        for (j = 0; j < bits; j++)
+        if (errorbit != -1)
         {
-            int byte = j / 8;
-            int bitmask = 1 << (7 - (j % 8));
-            uint32_t crc1, crc2;
+            int j = errorbit & 0xFF;
+            int i = errorbit >> 8;
 
-            memcpy(aux, msg, bits / 8);
-            aux[byte] ^= bitmask; /* Flip j-th bit. */
-
-            crc1 = ((uint32_t)aux[(bits / 8) - 3] << 16) |
-                   ((uint32_t)aux[(bits / 8) - 2] << 8) |
-                   (uint32_t)aux[(bits / 8) - 1];
-            crc2 = modesChecksum(aux, bits);
-
-            if (crc1 == crc2)
-            {
-                /* The error is fixed. Overwrite the original buffer with
-                    * the corrected sequence, and returns the error bit
-                    * position. */
-                memcpy(msg, aux, bits / 8);
-                return j;
-            }
+            msg[j / 8] ^= 1 << (7 - (j % 8)); /* Flip j-th bit. */
+            if (i)
+                msg[i / 8] ^= 1 << (7 - (i % 8)); /* Flip i-th bit. */
         }
-        return -1;
+        return errorbit;
     }
 
-    int ModeS::fixTwoBitsErrors(unsigned char *msg, int bits)
+    int FixSingleBitErrors(unsigned char *msg, int bits)
     {
-        int j, i;
-        unsigned char aux[MODES_LONG_MSG_BITS / 8];
-
-        for (j = 0; j < bits; j++)
-        {
-            int byte1 = j / 8;
-            int bitmask1 = 1 << (7 - (j % 8));
-
-            /* Don't check the same pairs multiple times, so i starts from j+1 */
-            for (i = j + 1; i < bits; i++)
-            {
-                int byte2 = i / 8;
-                int bitmask2 = 1 << (7 - (i % 8));
-                uint32_t crc1, crc2;
-
-                memcpy(aux, msg, bits / 8);
-
-                aux[byte1] ^= bitmask1; /* Flip j-th bit. */
-                aux[byte2] ^= bitmask2; /* Flip i-th bit. */
-
-                crc1 = ((uint32_t)aux[(bits / 8) - 3] << 16) |
-                       ((uint32_t)aux[(bits / 8) - 2] << 8) |
-                       (uint32_t)aux[(bits / 8) - 1];
-                crc2 = modesChecksum(aux, bits);
-
-                if (crc1 == crc2)
-                {
-                    /* The error is fixed. Overwrite the original buffer with
-                        * the corrected sequence, and returns the error bit
-                        * position. */
-                    memcpy(msg, aux, bits / 8);
-                    /* We return the two bits as a 16 bit integer by shifting
-                        * 'i' on the left. This is possible since 'i' will always
-                        * be non-zero because i starts from j+1. */
-                    return j | (i << 8);
-                }
-            }
-        }
-        return -1;
+        uint32_t syndrome = CRC24::MessageChecksum(msg, bits) ^ CRC24::MessageParity(msg, bits);
+        return FixBitErrors(msg, bits, syndrome, 1);
     }
 
-    uint32_t ModeS::ICAOCacheHashAddress(uint32_t a)
+    int FixTwoBitsErrors(unsigned char *msg, int bits)
     {
-        /* The following three rounds wil make sure that every bit affects
-            * every output bit with ~ 50% of probability. */
-        a = ((a >> 16) ^ a) * 0x45d9f3b;
-        a = ((a >> 16) ^ a) * 0x45d9f3b;
-        a = ((a >> 16) ^ a);
-        return a & (MODES_ICAO_CACHE_LEN - 1);
+        uint32_t syndrome = CRC24::MessageChecksum(msg, bits) ^ CRC24::MessageParity(msg, bits);
+        return FixBitErrors(msg, bits, syndrome, 2);
     }
 
     void ModeS::addRecentlySeenICAOAddr(uint32_t addr)
     {
-        uint32_t h = ICAOCacheHashAddress(addr);
-        icao_cache[h * 2] = addr;
-        icao_cache[h * 2 + 1] = (uint32_t)time(NULL);
+        icao_cache.Add(addr, _now);
     }
 
     int ModeS::ICAOAddressWasRecentlySeen(uint32_t addr)
     {
-        uint32_t h = ICAOCacheHashAddress(addr);
-        uint32_t a = icao_cache[h * 2];
-        uint32_t t = icao_cache[h * 2 + 1];
-
-        return a && a == addr && time(NULL) - t <= MODES_ICAO_CACHE_TTL;
+        return icao_cache.Contains(addr, _now);
     }
 
     int ModeS::bruteForceAP(unsigned char *msg, struct modesMessage *mm)
@@ -143,7 +72,7 @@ namespace ssr::ads_b::transport
             msgtype == 16 || /* Long Air-Air survillance */
             msgtype == 20 || /* Comm-A, altitude request */
             msgtype == 21 || /* Comm-A, identity request */
-            msgtype == 24)   /* Comm-C ELM */
+            msgtype >= 24)   /* Comm-D ELM */
         {
             uint32_t addr;
             uint32_t crc;
@@ -177,275 +106,498 @@ namespace ssr::ads_b::transport
 
     int ModeS::decodeAC13Field(unsigned char *msg, int *unit)
     {
-        int m_bit = msg[3] & (1 << 6);
-        int q_bit = msg[3] & (1 << 4);
+        int field = ((msg[2] & 0x1F) << 8) | msg[3];
 
-        if (!m_bit)
-        {
-            *unit = MODES_UNIT_FEET;
-            if (q_bit)
-            {
-                /* N is the 11 bit integer resulting from the removal of bit
-                    * Q and M */
-                int n = ((msg[2] & 31) << 6) |
-                        ((msg[3] & 0x80) >> 2) |
-                        ((msg[3] & 0x20) >> 1) |
-                        (msg[3] & 15);
-                /* The final altitude is due to the resulting number multiplied
-                    * by 25, minus 1000. */
-                return n * 25 - 1000;
-            }
-            else
-            {
-                /* TODO: Implement altitude where Q=0 and M=0 */
-            }
-        }
-        else
-        {
-            *unit = MODES_UNIT_METERS;
-            /* TODO: Implement altitude when meter unit is selected. */
-        }
-        return 0;
+        *unit = AltitudeCode::IsMetric(field) ? MODES_UNIT_METERS : MODES_UNIT_FEET;
+        return AltitudeCode::AC13[field];
     }
 
     int ModeS::decodeAC12Field(unsigned char *msg, int *unit)
     {
-        int q_bit = msg[5] & 1;
+        *unit = MODES_UNIT_FEET;
+        return AltitudeCode::AC12[(msg[5] << 4) | (msg[6] >> 4)];
+    }
+
+    /* Squawk of the 13 bit identity field (DF5/21), see ModeAPulses() */
+    static int decodeID13Field(const unsigned char *msg)
+    {
+        return AltitudeCode::ID13[((msg[2] & 0x1F) << 8) | msg[3]];
+    }
+
+    /* Surface movement field to ground speed in knots, 0 if unknown */
+    static int decodeMovement(int movement)
+    {
+        if (movement <= 1)
+            return 0; /* No information or stopped */
+        if (movement <= 8)
+            return 1; /* 0.125 to 1 kt */
+        if (movement <= 12)
+            return 1 + (movement - 9) / 4;
+        if (movement <= 38)
+            return 2 + (movement - 13) / 2;
+        if (movement <= 93)
+            return 15 + (movement - 39);
+        if (movement <= 108)
+            return 70 + (movement - 94) * 2;
+        if (movement <= 123)
+            return 100 + (movement - 109) * 5;
+        return 175; /* 175 kt or more */
+    }
 
-        if (q_bit)
+    /* Fields of the surveillance and Comm-B replies (DF4/5/20/21) */
+    static void decodeFlightStatus(struct modesMessage *mm, const unsigned char *msg)
+    {
+        mm->fs = msg[0] & 7;           /* Flight status for DF4,5,20,21 */
+        mm->dr = msg[1] >> 3 & 31;     /* Request extraction of downlink request. */
+        mm->um = ((msg[1] & 7) << 3) | /* Request extraction of downlink request. */
+                 msg[2] >> 5;
+    }
+
+    /* Address announced in the clear (DF11/17/18/19) */
+    static void decodeAA(struct modesMessage *mm, const unsigned char *msg)
+    {
+        mm->aa1 = msg[1];
+        mm->aa2 = msg[2];
+        mm->aa3 = msg[3];
+    }
+
+    /*
+     * Extended squitter ME field, one decoder per type code.
+     *
+     * The primary template handles type codes that are not decoded, every
+     * specialization only extracts the fields its format carries. Type codes
+     * sharing a layout forward to the first of their range.
+     */
+    template <int TC>
+    struct EsDecoder
+    {
+        static void Decode(ModeS &, struct modesMessage *, unsigned char *) {}
+    };
+
+    /* Aircraft Identification and Category */
+    template <>
+    struct EsDecoder<1>
+    {
+        static void Decode(ModeS &, struct modesMessage *mm, unsigned char *msg)
         {
-            /* N is the 11 bit integer resulting from the removal of bit
-                * Q */
-            *unit = MODES_UNIT_FEET;
-            int n = ((msg[5] >> 1) << 4) | ((msg[6] & 0xF0) >> 4);
-            /* The final altitude is due to the resulting number multiplied
-                * by 25, minus 1000. */
-            return n * 25 - 1000;
+            static const char *ais_charset = "?ABCDEFGHIJKLMNOPQRSTUVWXYZ????? ???????????????0123456789??????";
+            const es::IdentAndCategory me{es::LoadME(msg)};
+
+            mm->aircraft_type = mm->metype - 1;
+            mm->flight[0] = ais_charset[me.char_1()];
+            mm->flight[1] = ais_charset[me.char_2()];
+            mm->flight[2] = ais_charset[me.char_3()];
+            mm->flight[3] = ais_charset[me.char_4()];
+            mm->flight[4] = ais_charset[me.char_5()];
+            mm->flight[5] = ais_charset[me.char_6()];
+            mm->flight[6] = ais_charset[me.char_7()];
+            mm->flight[7] = ais_charset[me.char_8()];
+            mm->flight[8] = '\0';
         }
-        else
+    };
+    template <> struct EsDecoder<2> : EsDecoder<1> {};
+    template <> struct EsDecoder<3> : EsDecoder<1> {};
+    template <> struct EsDecoder<4> : EsDecoder<1> {};
+
+    /* Surface position, the CPR fields use the surface encoding */
+    template <>
+    struct EsDecoder<5>
+    {
+        static void Decode(ModeS &, struct modesMessage *mm, unsigned char *msg)
         {
-            return 0;
+            const es::SurfacePosition me{es::LoadME(msg)};
+
+            mm->velocity = decodeMovement(me.movement());
+            mm->velocity_is_valid = me.movement() >= 1 && me.movement() <= 124;
+            mm->heading_is_valid = me.status();
+            mm->heading = (360 * me.ground_track()) / 128;
+            mm->fflag = me.f_flag();
+            mm->tflag = me.t_flag();
+            mm->raw_latitude = me.latitude();
+            mm->raw_longitude = me.longitude();
         }
-    }
+    };
+    template <> struct EsDecoder<6> : EsDecoder<5> {};
+    template <> struct EsDecoder<7> : EsDecoder<5> {};
+    template <> struct EsDecoder<8> : EsDecoder<5> {};
+
+    /* Airborne position with barometric altitude */
+    template <>
+    struct EsDecoder<9>
+    {
+        static void Decode(ModeS &modes, struct modesMessage *mm, unsigned char *msg)
+        {
+            const es::AirbornePosition me{es::LoadME(msg)};
 
-    void ModeS::decodeModesMessage(struct modesMessage *mm, unsigned char *msg)
+            mm->fflag = me.f_flag();
+            mm->tflag = me.t_flag();
+            mm->altitude = modes.decodeAC12Field(msg, &mm->unit);
+            mm->raw_latitude = me.latitude();
+            mm->raw_longitude = me.longitude();
+        }
+    };
+    template <> struct EsDecoder<10> : EsDecoder<9> {};
+    template <> struct EsDecoder<11> : EsDecoder<9> {};
+    template <> struct EsDecoder<12> : EsDecoder<9> {};
+    template <> struct EsDecoder<13> : EsDecoder<9> {};
+    template <> struct EsDecoder<14> : EsDecoder<9> {};
+    template <> struct EsDecoder<15> : EsDecoder<9> {};
+    template <> struct EsDecoder<16> : EsDecoder<9> {};
+    template <> struct EsDecoder<17> : EsDecoder<9> {};
+    template <> struct EsDecoder<18> : EsDecoder<9> {};
+
+    /* Airborne position with GNSS height, a plain count of metres instead
+     * of an altitude code */
+    template <>
+    struct EsDecoder<20>
     {
-        uint32_t crc2; /* Computed CRC, used to verify the message CRC. */
-        const char *ais_charset = "?ABCDEFGHIJKLMNOPQRSTUVWXYZ????? ???????????????0123456789??????";
+        static void Decode(ModeS &, struct modesMessage *mm, unsigned char *msg)
+        {
+            const es::AirbornePosition me{es::LoadME(msg)};
+
+            mm->fflag = me.f_flag();
+            mm->tflag = me.t_flag();
+            mm->altitude = me.altitude();
+            mm->unit = MODES_UNIT_METERS;
+            mm->raw_latitude = me.latitude();
+            mm->raw_longitude = me.longitude();
+        }
+    };
+    template <> struct EsDecoder<21> : EsDecoder<20> {};
+    template <> struct EsDecoder<22> : EsDecoder<20> {};
 
-        /* Work on our local copy */
-        memcpy(mm->msg, msg, MODES_LONG_MSG_BYTES);
-        msg = mm->msg;
+    /* Airborne Velocity Message */
+    template <>
+    struct EsDecoder<19>
+    {
+        static void Decode(ModeS &, struct modesMessage *mm, unsigned char *msg)
+        {
+            /* Subtypes 2 and 4 are for supersonic aircraft, their speeds
+             * count in 4 kt steps instead of 1 kt. */
+            int scale = (mm->mesub == 2 || mm->mesub == 4) ? 4 : 1;
 
-        /* Get the message type ASAP as other operations depend on this */
-        mm->msgtype = msg[0] >> 3; /* Downlink Format */
-        mm->msgbits = modesMessageLenByType(mm->msgtype);
+            if (mm->mesub == 1 || mm->mesub == 2)
+            {
+                const es::GroundSpeed me{es::LoadME(msg)};
+
+                mm->ew_dir = me.ew_direction();
+                mm->ew_velocity = decodeSpeed(me.ew_velocity(), scale);
+                mm->ns_dir = me.ns_direction();
+                mm->ns_velocity = decodeSpeed(me.ns_velocity(), scale);
+                mm->vert_rate_source = me.vr_source();
+                mm->vert_rate_sign = me.vr_direction();
+                mm->vert_rate = me.vertical_rate();
+
+                /* A component of 0 means no information, not 0 kt */
+                if (me.ew_velocity() && me.ns_velocity())
+                {
+                    GroundVector v = Cordic::Polar(mm->ns_dir ? -mm->ns_velocity : mm->ns_velocity,
+                                                   mm->ew_dir ? -mm->ew_velocity : mm->ew_velocity);
+                    mm->velocity = v.speed;
+                    mm->velocity_is_valid = 1;
+                    mm->heading = v.track;
+                    mm->heading_is_valid = v.speed != 0;
+                }
+            }
+            else if (mm->mesub == 3 || mm->mesub == 4)
+            {
+                const es::AirSpeed me{es::LoadME(msg)};
+
+                mm->heading_is_valid = me.status();
+                mm->heading = ((me.heading() * 360 + 512) >> 10) % 360;
+                mm->velocity = decodeSpeed(me.airspeed(), scale);
+                mm->velocity_is_valid = me.airspeed() != 0;
+                mm->vert_rate_source = me.vr_source();
+                mm->vert_rate_sign = me.vr_direction();
+                mm->vert_rate = me.vertical_rate();
+            }
+        }
 
-        /* CRC is always the last three bytes. */
-        mm->crc = ((uint32_t)msg[(mm->msgbits / 8) - 3] << 16) |
-                  ((uint32_t)msg[(mm->msgbits / 8) - 2] << 8) |
-                  (uint32_t)msg[(mm->msgbits / 8) - 1];
-        crc2 = modesChecksum(msg, mm->msgbits);
+    private:
+        /* Speed field to knots, 0 for no information */
+        static int decodeSpeed(int field, int scale)
+        {
+            return field ? (field - 1) * scale : 0;
+        }
+    };
+
+    /*
+     * Downlink formats, one decoder per DF.
+     *
+     * Called after the CRC check and error correction. The primary template
+     * handles formats that are not decoded, their CRC can't be checked.
+     */
+    template <int DF>
+    struct Decoder
+    {
+        static void Decode(ModeS &, struct modesMessage *mm, unsigned char *)
+        {
+            mm->crcok = 0;
+        }
+    };
 
-        /* Check CRC and fix single bit errors using the CRC when
-            * possible (DF 11 and 17). */
-        mm->errorbit = -1; /* No error */
-        mm->crcok = (mm->crc == crc2);
+    /* Formats with the address xored into the parity (AP) field: the message
+     * is only valid if the recovered address was recently seen. */
+    struct APDecoder
+    {
+        static void Decode(ModeS &modes, struct modesMessage *mm, unsigned char *msg)
+        {
+            mm->crcok = modes.bruteForceAP(msg, mm);
+        }
+    };
 
-        if (!mm->crcok && FIX_1_BIT_ERRORS &&
-            (mm->msgtype == 11 || mm->msgtype == 17))
+    /* Formats with the address in the clear (AA) and a plain parity field */
+    struct AADecoder
+    {
+        static void Decode(ModeS &modes, struct modesMessage *mm, unsigned char *msg, bool whitelist)
         {
-            if ((mm->errorbit = fixSingleBitErrors(msg, mm->msgbits)) != -1)
-            {
-                mm->crc = modesChecksum(msg, mm->msgbits);
-                mm->crcok = 1;
-            }
-            else if (FIX_2_BIT_ERRORS && mm->msgtype == 17 &&
-                     (mm->errorbit = fixTwoBitsErrors(msg, mm->msgbits)) != -1)
+            mm->ca = msg[0] & 7; /* Responder capabilities. */
+            decodeAA(mm, msg);
+
+            /* If the checksum was ok we can add this address to the list
+             * of recently seen addresses. */
+            if (whitelist && mm->crcok && mm->errorbit == -1)
             {
-                mm->crc = modesChecksum(msg, mm->msgbits);
-                mm->crcok = 1;
+                uint32_t addr = (mm->aa1 << 16) | (mm->aa2 << 8) | mm->aa3;
+                modes.addRecentlySeenICAOAddr(addr);
             }
         }
+    };
 
-        /* Note that most of the other computation happens *after* we fix
-            * the single bit errors, otherwise we would need to recompute the
-            * fields again. */
-        mm->ca = msg[0] & 7; /* Responder capabilities. */
+    using EsDecodeFn = void (*)(ModeS &, struct modesMessage *, unsigned char *);
 
-        /* ICAO address */
-        mm->aa1 = msg[1];
-        mm->aa2 = msg[2];
-        mm->aa3 = msg[3];
+    template <size_t... TC>
+    static constexpr std::array<EsDecodeFn, sizeof...(TC)> makeEsDecoders(std::index_sequence<TC...>)
+    {
+        return {{&EsDecoder<TC>::Decode...}};
+    }
+
+    /* Jump table indexed by type code */
+    static constexpr auto es_decoders = makeEsDecoders(std::make_index_sequence<32>{});
 
-        /* DF 17 type (assuming this is a DF17, otherwise not used) */
+    /* ME field of DF17/18/19 */
+    static void decodeExtendedSquitter(ModeS &modes, struct modesMessage *mm, unsigned char *msg)
+    {
         mm->metype = msg[4] >> 3; /* Extended squitter message type. */
         mm->mesub = msg[4] & 7;   /* Extended squitter message subtype. */
+        es_decoders[mm->metype](modes, mm, msg);
+    }
 
-        /* Fields for DF4,5,20,21 */
-        mm->fs = msg[0] & 7;           /* Flight status for DF4,5,20,21 */
-        mm->dr = msg[1] >> 3 & 31;     /* Request extraction of downlink request. */
-        mm->um = ((msg[1] & 7) << 3) | /* Request extraction of downlink request. */
-                 msg[2] >> 5;
+    /* Short air surveillance */
+    template <>
+    struct Decoder<0>
+    {
+        static void Decode(ModeS &modes, struct modesMessage *mm, unsigned char *msg)
+        {
+            APDecoder::Decode(modes, mm, msg);
+            mm->altitude = modes.decodeAC13Field(msg, &mm->unit);
+        }
+    };
 
-        /* In the squawk (identity) field bits are interleaved like that
-            * (message bit 20 to bit 32):
-            *
-            * C1-A1-C2-A2-C4-A4-ZERO-B1-D1-B2-D2-B4-D4
-            *
-            * So every group of three bits A, B, C, D represent an integer
-            * from 0 to 7.
-            *
-            * The actual meaning is just 4 octal numbers, but we convert it
-            * into a base ten number tha happens to represent the four
-            * octal numbers.
-            *
-            * For more info: http://en.wikipedia.org/wiki/Gillham_code */
+    /* Surveillance, altitude reply */
+    template <>
+    struct Decoder<4>
+    {
+        static void Decode(ModeS &modes, struct modesMessage *mm, unsigned char *msg)
         {
-            int a, b, c, d;
-
-            a = ((msg[3] & 0x80) >> 5) |
-                ((msg[2] & 0x02) >> 0) |
-                ((msg[2] & 0x08) >> 3);
-            b = ((msg[3] & 0x02) << 1) |
-                ((msg[3] & 0x08) >> 2) |
-                ((msg[3] & 0x20) >> 5);
-            c = ((msg[2] & 0x01) << 2) |
-                ((msg[2] & 0x04) >> 1) |
-                ((msg[2] & 0x10) >> 4);
-            d = ((msg[3] & 0x01) << 2) |
-                ((msg[3] & 0x04) >> 1) |
-                ((msg[3] & 0x10) >> 4);
-            mm->identity = a * 1000 + b * 100 + c * 10 + d;
+            APDecoder::Decode(modes, mm, msg);
+            decodeFlightStatus(mm, msg);
+            mm->altitude = modes.decodeAC13Field(msg, &mm->unit);
         }
+    };
 
-        /* DF 11 & 17: try to populate our ICAO addresses whitelist.
-            * DFs with an AP field (xored addr and crc), try to decode it. */
-        if (mm->msgtype != 11 && mm->msgtype != 17)
+    /* Surveillance, identity reply */
+    template <>
+    struct Decoder<5>
+    {
+        static void Decode(ModeS &modes, struct modesMessage *mm, unsigned char *msg)
         {
-            /* Check if we can check the checksum for the Downlink Formats where
-                * the checksum is xored with the aircraft ICAO address. We try to
-                * brute force it using a list of recently seen aircraft addresses. */
-            if (bruteForceAP(msg, mm))
-            {
-                /* We recovered the message, mark the checksum as valid. */
-                mm->crcok = 1;
-            }
-            else
-            {
-                mm->crcok = 0;
-            }
+            APDecoder::Decode(modes, mm, msg);
+            decodeFlightStatus(mm, msg);
+            mm->identity = decodeID13Field(msg);
         }
-        else
+    };
+
+    /* All-Call reply */
+    template <>
+    struct Decoder<11>
+    {
+        static void Decode(ModeS &modes, struct modesMessage *mm, unsigned char *msg)
         {
-            /* If this is DF 11 or DF 17 and the checksum was ok,
-                * we can add this address to the list of recently seen
-                * addresses. */
-            if (mm->crcok && mm->errorbit == -1)
-            {
-                uint32_t addr = (mm->aa1 << 16) | (mm->aa2 << 8) | mm->aa3;
-                addRecentlySeenICAOAddr(addr);
-            }
+            AADecoder::Decode(modes, mm, msg, true);
         }
+    };
 
-        /* Decode 13 bit altitude for DF0, DF4, DF16, DF20 */
-        if (mm->msgtype == 0 || mm->msgtype == 4 ||
-            mm->msgtype == 16 || mm->msgtype == 20)
+    /* Long Air-Air surveillance */
+    template <>
+    struct Decoder<16> : Decoder<0> {};
+
+    /* Extended squitter */
+    template <>
+    struct Decoder<17>
+    {
+        static void Decode(ModeS &modes, struct modesMessage *mm, unsigned char *msg)
         {
-            mm->altitude = decodeAC13Field(msg, &mm->unit);
+            AADecoder::Decode(modes, mm, msg, true);
+            decodeExtendedSquitter(modes, mm, msg);
         }
+    };
 
-        /* Decode extended squitter specific stuff. */
-        if (mm->msgtype == 17)
+    /* Extended squitter from non-transponder devices and TIS-B/ADS-R.
+     * CF 0-2, 5 and 6 carry the DF17 ME formats, only CF 0 is guaranteed
+     * to be a real ICAO address and goes into the whitelist. */
+    template <>
+    struct Decoder<18>
+    {
+        static void Decode(ModeS &modes, struct modesMessage *mm, unsigned char *msg)
         {
-            /* Decode the extended squitter message. */
+            int cf = msg[0] & 7;
 
-            if (mm->metype >= 1 && mm->metype <= 4)
-            {
-                /* Aircraft Identification and Category */
-                mm->aircraft_type = mm->metype - 1;
-                mm->flight[0] = ais_charset[msg[5] >> 2];
-                mm->flight[1] = ais_charset[((msg[5] & 3) << 4) | (msg[6] >> 4)];
-                mm->flight[2] = ais_charset[((msg[6] & 15) << 2) | (msg[7] >> 6)];
-                mm->flight[3] = ais_charset[msg[7] & 63];
-                mm->flight[4] = ais_charset[msg[8] >> 2];
-                mm->flight[5] = ais_charset[((msg[8] & 3) << 4) | (msg[9] >> 4)];
-                mm->flight[6] = ais_charset[((msg[9] & 15) << 2) | (msg[10] >> 6)];
-                mm->flight[7] = ais_charset[msg[10] & 63];
-                mm->flight[8] = '\0';
-            }
-            else if (mm->metype >= 9 && mm->metype <= 18)
+            AADecoder::Decode(modes, mm, msg, cf == 0);
+            if (cf <= 2 || cf == 5 || cf == 6)
+                decodeExtendedSquitter(modes, mm, msg);
+        }
+    };
+
+    /* Military extended squitter, AF 0 uses the DF17 layout */
+    template <>
+    struct Decoder<19>
+    {
+        static void Decode(ModeS &modes, struct modesMessage *mm, unsigned char *msg)
+        {
+            if ((msg[0] & 7) != 0)
             {
-                /* Airborne position Message */
-                mm->fflag = msg[6] & (1 << 2);
-                mm->tflag = msg[6] & (1 << 3);
-                mm->altitude = decodeAC12Field(msg, &mm->unit);
-                mm->raw_latitude = ((msg[6] & 3) << 15) |
-                                   (msg[7] << 7) |
-                                   (msg[8] >> 1);
-                mm->raw_longitude = ((msg[8] & 1) << 16) |
-                                    (msg[9] << 8) |
-                                    msg[10];
+                mm->crcok = 0;
+                return;
             }
-            else if (mm->metype == 19 && mm->mesub >= 1 && mm->mesub <= 4)
+            AADecoder::Decode(modes, mm, msg, false);
+            decodeExtendedSquitter(modes, mm, msg);
+        }
+    };
+
+    /* Comm-B, altitude reply */
+    template <>
+    struct Decoder<20> : Decoder<4> {};
+
+    /* Comm-B, identity reply */
+    template <>
+    struct Decoder<21> : Decoder<5> {};
+
+    /* Comm-D ELM, DF24 and up */
+    template <>
+    struct Decoder<24> : APDecoder {};
+    template <> struct Decoder<25> : APDecoder {};
+    template <> struct Decoder<26> : APDecoder {};
+    template <> struct Decoder<27> : APDecoder {};
+    template <> struct Decoder<28> : APDecoder {};
+    template <> struct Decoder<29> : APDecoder {};
+    template <> struct Decoder<30> : APDecoder {};
+    template <> struct Decoder<31> : APDecoder {};
+
+    using DecodeFn = void (*)(ModeS &, struct modesMessage *, unsigned char *);
+
+    template <size_t... DF>
+    static constexpr std::array<DecodeFn, sizeof...(DF)> makeDecoders(std::index_sequence<DF...>)
+    {
+        return {{&Decoder<DF>::Decode...}};
+    }
+
+    /* Jump table indexed by downlink format */
+    static constexpr auto decoders = makeDecoders(std::make_index_sequence<32>{});
+
+    void ModeS::decodeModesMessage(struct modesMessage *mm, unsigned char *msg, const RawFrame *frame)
+    {
+        uint32_t crc2; /* Computed CRC, used to verify the message CRC. */
+
+        /* Work on our local copy */
+        memcpy(mm->msg, msg, MODES_LONG_MSG_BYTES);
+        msg = mm->msg;
+
+        /* Get the message type ASAP as other operations depend on this */
+        mm->msgtype = msg[0] >> 3; /* Downlink Format */
+        mm->msgbits = modesMessageLenByType(mm->msgtype);
+
+        /* CRC is always the last three bytes. */
+        mm->crc = CRC24::MessageParity(msg, mm->msgbits);
+        mm->errorbit = -1; /* No error */
+
+        if (frame && frame->checked)
+        {
+            /* Checked and corrected on the way in, see Mixer::route() */
+            mm->crcok = frame->syndrome == 0;
+            mm->errorbit = frame->errorbit;
+        }
+        else
+        {
+            crc2 = modesChecksum(msg, mm->msgbits);
+            mm->crcok = (mm->crc == crc2);
+
+            /* Check CRC and fix single bit errors using the CRC when
+                * possible (DF 11, 17 and 18). Two bit errors only for DF17/18. */
+            if (!mm->crcok && FIX_1_BIT_ERRORS &&
+                (mm->msgtype == 11 || mm->msgtype == 17 || mm->msgtype == 18))
             {
-                /* Airborne Velocity Message */
-                if (mm->mesub == 1 || mm->mesub == 2)
-                {
-                    mm->ew_dir = (msg[5] & 4) >> 2;
-                    mm->ew_velocity = ((msg[5] & 3) << 8) | msg[6];
-                    mm->ns_dir = (msg[7] & 0x80) >> 7;
-                    mm->ns_velocity = ((msg[7] & 0x7f) << 3) | ((msg[8] & 0xe0) >> 5);
-                    mm->vert_rate_source = (msg[8] & 0x10) >> 4;
-                    mm->vert_rate_sign = (msg[8] & 0x8) >> 3;
-                    mm->vert_rate = ((msg[8] & 7) << 6) | ((msg[9] & 0xfc) >> 2);
-                    /* Compute velocity and angle from the two speed
-                        * components. */
-                    mm->velocity = sqrt(mm->ns_velocity * mm->ns_velocity +
-                                        mm->ew_velocity * mm->ew_velocity);
-                    if (mm->velocity)
-                    {
-                        int ewv = mm->ew_velocity;
-                        int nsv = mm->ns_velocity;
-                        double heading;
-
-                        if (mm->ew_dir)
-                            ewv *= -1;
-                        if (mm->ns_dir)
-                            nsv *= -1;
-                        heading = atan2(ewv, nsv);
-
-                        /* Convert to degrees. */
-                        mm->heading = heading * 360 / (M_PI * 2);
-                        /* We don't want negative values but a 0-360 scale. */
-                        if (mm->heading < 0)
-                            mm->heading += 360;
-                    }
-                    else
-                    {
-                        mm->heading = 0;
-                    }
-                }
-                else if (mm->mesub == 3 || mm->mesub == 4)
+                int maxErrors = (FIX_2_BIT_ERRORS && mm->msgtype != 11) ? 2 : 1;
+
+                if ((mm->errorbit = FixBitErrors(msg, mm->msgbits, mm->crc ^ crc2, maxErrors)) != -1)
                 {
-                    mm->heading_is_valid = msg[5] & (1 << 2);
-                    mm->heading = (360.0 / 128) * (((msg[5] & 3) << 5) |
-                                                   (msg[6] >> 3));
+                    mm->crc = modesChecksum(msg, mm->msgbits);
+                    mm->crcok = 1;
                 }
             }
         }
+
+        /* Note that the fields are decoded *after* we fix the bit errors,
+            * otherwise we would need to recompute them again. */
+        decoders[mm->msgtype](*this, mm, msg);
+
         mm->phase_corrected = 0; /* Set to 1 by the caller if needed. */
     }
 
-    int ModeS::hexDigitVal(int c)
+    size_t ModeS::decodeBatch(const RawFrame *frames, size_t count, MessageBatch &out)
     {
-        c = tolower(c);
-        if (c >= '0' && c <= '9')
-            return c - '0';
-        else if (c >= 'a' && c <= 'f')
-            return c - 'a' + 10;
-        else
-            return -1;
+        size_t n;
+
+        for (n = 0; n < count && !out.Full(); n++)
+        {
+            const RawFrame &frame = frames[n];
+            unsigned char msg[MODES_LONG_MSG_BYTES] = {};
+            struct modesMessage mm = {};
+            size_t i = out.size++;
+
+            memcpy(msg, frame.data, frame.len > MODES_LONG_MSG_BYTES ? MODES_LONG_MSG_BYTES : frame.len);
+            decodeModesMessage(&mm, msg, &frame);
+
+            memcpy(out.msg[i], mm.msg, MODES_LONG_MSG_BYTES);
+            out.msgbits[i] = mm.msgbits;
+            out.df[i] = mm.msgtype;
+            out.ca[i] = mm.msg[0] & 7; /* CA, CF or FS depending on the DF */
+            out.icao[i] = (mm.aa1 << 16) | (mm.aa2 << 8) | mm.aa3;
+            out.crcok[i] = mm.crcok;
+            out.errorbit[i] = mm.errorbit;
+            out.timestamp[i] = frame.timestamp;
+            out.signal[i] = frame.signal;
+            out.time[i] = frame.time;
+            out.source[i] = frame.source;
+
+            out.metype[i] = mm.metype;
+            out.mesub[i] = mm.mesub;
+            out.fflag[i] = mm.fflag ? 1 : 0;
+            out.raw_latitude[i] = mm.raw_latitude;
+            out.raw_longitude[i] = mm.raw_longitude;
+            memcpy(out.flight[i], mm.flight, sizeof(mm.flight));
+            out.velocity[i] = mm.velocity;
+            out.heading[i] = mm.heading;
+            out.velocity_valid[i] = mm.velocity_is_valid ? 1 : 0;
+            out.heading_valid[i] = mm.heading_is_valid ? 1 : 0;
+            out.vert_rate[i] = mm.vert_rate ? (mm.vert_rate - 1) * 64 * (mm.vert_rate_sign ? -1 : 1) : 0;
+
+            out.altitude[i] = mm.altitude;
+            out.unit[i] = mm.unit;
+            out.identity[i] = mm.identity;
+            out.position[i] = 0;
+        }
+        return n;
     }
 
 } // namespace ssr::decoder
\ No newline at end of file
@@ -1,19 +1,31 @@
 #include <iostream>
+#include <thread>
+#include <vector>
+#include <algorithm>
 
 #include <uvw.hpp>
 #include <cxxopts.hpp>
 
 #include <ports/avr.hpp>
+#include <ports/beast.hpp>
+#include <ports/sbs.hpp>
 
 int main(int argc, char** argv) {
     cxxopts::Options options("ssr_mixer", "SSR Mixer service");
 
+    /* Leave one core for the I/O loop */
+    unsigned int cores = std::thread::hardware_concurrency();
+    unsigned int workers = cores > 1 ? cores - 1 : 1;
+
     options.add_options()
 
         ("v,verbose", "Verbose output")
         ("b,bar", "Param bar", cxxopts::value<std::string>())
         ("d,debug", "Enable debugging", cxxopts::value<bool>()->default_value("false"))
         ("f,foo", "Param foo", cxxopts::value<int>()->default_value("10"))
+        ("w,workers", "Decode worker threads", cxxopts::value<unsigned int>()->default_value(std::to_string(workers)))
+        ("l,loops", "I/O loops accepting feeders, each on its own thread", cxxopts::value<unsigned int>()->default_value("1"))
+        ("m,merge-latency", "Max ms frames are held to forward them in receive time order, 0 to disable", cxxopts::value<unsigned int>()->default_value("0"))
         ("h,help", "Print usage")
     ;
 
@@ -30,13 +42,46 @@ int main(int argc, char** argv) {
 
     spdlog::info("ssr_mixer is starting!");
 
+    unsigned int loops = std::max(1u, result["loops"].as<unsigned int>());
     auto loop = uvw::Loop::getDefault();
 
-    auto avrIn = new ssr::ports::AVR(40002);
-    avrIn->Init(*loop);
+    ssr::mixer::Mixer mixer(result["workers"].as<unsigned int>(), loops, result["merge-latency"].as<unsigned int>());
+    mixer.Init(*loop);
+
+    /* Every loop gets its own listeners, framers and decoder, the kernel
+     * spreads new connections over them with SO_REUSEPORT. Loop 0 is the
+     * default loop, it also delivers the mixer output. */
+    std::vector<std::shared_ptr<uvw::Loop>> ioLoops = {loop};
+    for (unsigned int i = 1; i < loops; i++) {
+        ioLoops.push_back(uvw::Loop::create());
+    }
+
+    for (unsigned int i = 0; i < loops; i++) {
+        auto avrIn = new ssr::ports::AVR(40002, mixer.In(i));
+        avrIn->ReusePort(loops > 1);
+        avrIn->Init(*ioLoops[i]);
+
+        auto beastIn = new ssr::ports::Beast(40005, mixer.In(i));
+        beastIn->ReusePort(loops > 1);
+        beastIn->Init(*ioLoops[i]);
+    }
+
+    /* Outputs run on the default loop, where the mixer delivers */
+    auto sbsOut = new ssr::ports::SBS(30003);
+    sbsOut->Init(*loop);
+    mixer.AddOutput([sbsOut](const ssr::mixer::Mixer::MessageBatch &batch) { sbsOut->Mix(batch); });
+
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < loops; i++) {
+        threads.emplace_back([l = ioLoops[i]] { l->run(); });
+    }
 
     loop->run();
 
+    for (auto &t : threads) {
+        t.join();
+    }
+
     spdlog::info("Bye :)");
     return 0;
 }
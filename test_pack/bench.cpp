@@ -0,0 +1,268 @@
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include <memory.h>
+
+#include <ads-b/modes.hpp>
+#include <ports/framer.hpp>
+
+#ifndef SSR_BENCH_CORPUS
+#define SSR_BENCH_CORPUS "test_pack/corpus.avr"
+#endif
+
+using namespace ssr::ads_b::transport;
+
+/* The original per-bit parity table, kept here as the reference implementation */
+static const uint32_t modes_checksum_table[112] = {
+	0x3935ea, 0x1c9af5, 0xf1b77e, 0x78dbbf, 0xc397db, 0x9e31e9, 0xb0e2f0, 0x587178,
+	0x2c38bc, 0x161c5e, 0x0b0e2f, 0xfa7d13, 0x82c48d, 0xbe9842, 0x5f4c21, 0xd05c14,
+	0x682e0a, 0x341705, 0xe5f186, 0x72f8c3, 0xc68665, 0x9cb936, 0x4e5c9b, 0xd8d449,
+	0x939020, 0x49c810, 0x24e408, 0x127204, 0x093902, 0x049c81, 0xfdb444, 0x7eda22,
+	0x3f6d11, 0xe04c8c, 0x702646, 0x381323, 0xe3f395, 0x8e03ce, 0x4701e7, 0xdc7af7,
+	0x91c77f, 0xb719bb, 0xa476d9, 0xadc168, 0x56e0b4, 0x2b705a, 0x15b82d, 0xf52612,
+	0x7a9309, 0xc2b380, 0x6159c0, 0x30ace0, 0x185670, 0x0c2b38, 0x06159c, 0x030ace,
+	0x018567, 0xff38b7, 0x80665f, 0xbfc92b, 0xa01e91, 0xaff54c, 0x57faa6, 0x2bfd53,
+	0xea04ad, 0x8af852, 0x457c29, 0xdd4410, 0x6ea208, 0x375104, 0x1ba882, 0x0dd441,
+	0xf91024, 0x7c8812, 0x3e4409, 0xe0d800, 0x706c00, 0x383600, 0x1c1b00, 0x0e0d80,
+	0x0706c0, 0x038360, 0x01c1b0, 0x00e0d8, 0x00706c, 0x003836, 0x001c1b, 0xfff409,
+	0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+	0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+	0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000};
+
+static uint32_t bitwiseChecksum(const unsigned char *msg, int bits)
+{
+	uint32_t crc = 0;
+	int offset = (bits == 112) ? 0 : (112 - 56);
+
+	for (int j = 0; j < bits; j++)
+	{
+		if (msg[j / 8] & (1 << (7 - (j % 8))))
+			crc ^= modes_checksum_table[j + offset];
+	}
+	return crc;
+}
+
+struct Frame
+{
+	std::string line;
+	unsigned char msg[14];
+	int bits;
+	int df;
+};
+
+static volatile uint64_t sink;
+
+/* Runs 'fn(i)' over 'count' items for at least 20 ms, 5 times, and reports
+ * the fastest run. Each call of 'fn' handles 'perCall' messages. */
+template <class TFn>
+static void bench(const std::string &name, size_t count, TFn fn, size_t perCall = 1)
+{
+	using clock = std::chrono::steady_clock;
+	double best = 1e30;
+
+	for (int run = 0; run < 5; run++)
+	{
+		uint64_t n = 0, acc = 0;
+		auto start = clock::now();
+		double elapsed;
+		do
+		{
+			for (size_t i = 0; i < count; i++)
+				acc += fn(i);
+			n += count;
+			elapsed = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+		} while (elapsed < 20);
+		sink += acc;
+
+		double ns = elapsed * 1e6 / (n * perCall);
+		if (ns < best)
+			best = ns;
+	}
+
+	std::cout << std::left << std::setw(36) << name
+			  << std::right << std::setw(10) << std::fixed << std::setprecision(1) << best << " ns/msg"
+			  << std::setw(14) << std::setprecision(0) << 1e9 / best << " msgs/s" << std::endl;
+}
+
+static std::vector<Frame> loadCorpus(const char *path)
+{
+	std::vector<Frame> frames;
+	std::ifstream in(path);
+	std::string line;
+
+	while (std::getline(in, line))
+	{
+		RawFrame raw;
+		if (line.empty() || line[0] == '#' || !ModeS::decodeHexFrame(line, raw))
+			continue;
+
+		Frame f = {};
+		f.line = line;
+		memcpy(f.msg, raw.data, raw.len);
+		f.bits = raw.len * 8;
+		f.df = raw.data[0] >> 3;
+		frames.push_back(f);
+	}
+	return frames;
+}
+
+/* Copies of the long frames with 'flips' random bits flipped */
+static std::vector<Frame> corrupt(const std::vector<Frame> &frames, int flips, std::mt19937 &rng)
+{
+	std::vector<Frame> out;
+	for (int round = 0; round < 16; round++)
+	{
+		for (auto f : frames)
+		{
+			if (f.df != 17)
+				continue;
+			int j = rng() % f.bits, i;
+			do
+				i = rng() % f.bits;
+			while (i == j);
+			f.msg[j / 8] ^= 1 << (7 - (j % 8));
+			if (flips == 2)
+				f.msg[i / 8] ^= 1 << (7 - (i % 8));
+			out.push_back(f);
+		}
+	}
+	return out;
+}
+
+/* CRC24 must match the per-bit table, and error correction must undo
+ * every corruption it is given. */
+static bool verify(const std::vector<Frame> &frames, const std::vector<Frame> &one, const std::vector<Frame> &two)
+{
+	for (auto f : frames)
+		if (CRC24::MessageChecksum(f.msg, f.bits) != bitwiseChecksum(f.msg, f.bits))
+			return false;
+	for (auto f : one)
+		if (FixSingleBitErrors(f.msg, f.bits) == -1 || CRC24::MessageChecksum(f.msg, f.bits) != CRC24::MessageParity(f.msg, f.bits))
+			return false;
+	for (auto f : two)
+		if (FixTwoBitsErrors(f.msg, f.bits) == -1 || CRC24::MessageChecksum(f.msg, f.bits) != CRC24::MessageParity(f.msg, f.bits))
+			return false;
+	return true;
+}
+
+/* Known frames decode to the expected fields */
+static bool verifyDecode(ModeS &modes)
+{
+	/* Airborne position with GNSS height (TC 20): 1234 m, CPR 93000/51372 */
+	static const unsigned char gnss[] = {0x8D, 0x4B, 0x96, 0x96, 0xA0, 0x4D, 0x22, 0xD6, 0x90, 0xC8, 0xAC, 0xFD, 0x3B, 0x3F};
+	modesMessage mm;
+
+	if (!modes.decodeBinaryMessage(gnss, sizeof(gnss), mm))
+		return false;
+	return mm.crcok && mm.metype == 20 && mm.altitude == 1234 && mm.unit == MODES_UNIT_METERS &&
+		   mm.raw_latitude == 93000 && mm.raw_longitude == 51372;
+}
+
+/*
+ * Decoder hot path microbenchmarks over the frames in test_pack/corpus.avr
+ *
+ * ssr_bench [corpus]
+ */
+int main(int argc, char **argv)
+{
+	const char *path = argc > 1 ? argv[1] : SSR_BENCH_CORPUS;
+	auto frames = loadCorpus(path);
+	if (frames.empty())
+	{
+		std::cerr << "No frames in " << path << std::endl;
+		return 1;
+	}
+
+	std::mt19937 rng(1090);
+	auto one = corrupt(frames, 1, rng);
+	auto two = corrupt(frames, 2, rng);
+
+	auto modes = std::make_unique<ModeS>();
+	if (!verify(frames, one, two))
+	{
+		std::cerr << "CRC / error correction mismatch" << std::endl;
+		return 1;
+	}
+	if (!verifyDecode(*modes))
+	{
+		std::cerr << "Decoded fields mismatch" << std::endl;
+		return 1;
+	}
+	std::cout << frames.size() << " frames from " << path << std::endl;
+
+	bench("modesChecksum (bitwise reference)", frames.size(), [&](size_t i) {
+		return bitwiseChecksum(frames[i].msg, frames[i].bits);
+	});
+	bench("CRC24::MessageChecksum", frames.size(), [&](size_t i) {
+		return CRC24::MessageChecksum(frames[i].msg, frames[i].bits);
+	});
+
+	bench("FixSingleBitErrors (DF17, 1 bit)", one.size(), [&](size_t i) {
+		Frame f = one[i];
+		return (uint64_t)FixSingleBitErrors(f.msg, f.bits);
+	});
+	bench("FixTwoBitsErrors (DF17, 2 bits)", two.size(), [&](size_t i) {
+		Frame f = two[i];
+		return (uint64_t)FixTwoBitsErrors(f.msg, f.bits);
+	});
+
+	bench("hex decoding (decodeHexFrame)", frames.size(), [&](size_t i) {
+		RawFrame raw;
+		return (uint64_t)ModeS::decodeHexFrame(frames[i].line, raw) + raw.data[3];
+	});
+
+	std::map<int, std::vector<Frame>> byDF;
+	for (auto &f : frames)
+		byDF[f.df].push_back(f);
+	for (auto &[df, group] : byDF)
+	{
+		bench("decodeBinaryMessage DF" + std::to_string(df), group.size(), [&](size_t i) {
+			modesMessage mm;
+			modes->decodeBinaryMessage(group[i].msg, group[i].bits / 8, mm);
+			return (uint64_t)mm.crcok + mm.altitude;
+		});
+	}
+
+	std::vector<RawFrame> raws(frames.size());
+	for (size_t i = 0; i < frames.size(); i++)
+		ModeS::decodeHexFrame(frames[i].line, raws[i]);
+	auto batch = std::make_unique<MessageBatch>();
+	bench("decodeBatch", raws.size(), [&](size_t i) {
+		if (i == 0)
+			batch->Clear();
+		return (uint64_t)modes->decodeBatch(&raws[i], 1, *batch);
+	});
+
+	/* Same work as AVR::ParseData: frame the stream and convert each line,
+	 * fed in TCP sized segments so lines get split across reads. */
+	std::string stream;
+	for (auto &f : frames)
+		stream += f.line + "\r\n";
+	while (stream.size() < 64 * 1024)
+		stream += stream;
+	size_t lines = 0;
+	for (char c : stream)
+		lines += c == '\n';
+
+	ssr::ports::LineFramer framer;
+	const size_t segment = 1448;
+	bench("AVR framing + hex (per line)", 1, [&](size_t) {
+		uint64_t n = 0;
+		for (size_t off = 0; off < stream.size(); off += segment)
+		{
+			size_t len = std::min(segment, stream.size() - off);
+			framer.Feed(stream.data() + off, len, [&](std::string_view line) {
+				RawFrame raw;
+				n += ModeS::decodeHexFrame(line, raw);
+			});
+		}
+		return n;
+	}, lines);
+
+	return 0;
+}